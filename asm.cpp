@@ -0,0 +1,30 @@
+#include "asm.h"
+
+const char* const OPCODE_NAMES[OPCODES] = {
+  "BR", "BRNEG", "BRZNEG", "BRPOS", "BRZPOS", "BRZERO",
+  "LOAD", "STORE", "ADD", "SUB", "MULT", "DIV", "READ", "WRITE", "NOOP", "STOP"
+};
+
+const Operand OPCODE_OPERANDS[OPCODES] = {
+  LABEL_arg, LABEL_arg, LABEL_arg, LABEL_arg, LABEL_arg, LABEL_arg,
+  VALUE_arg, VARIABLE_arg, VALUE_arg, VALUE_arg, VALUE_arg, VALUE_arg, VARIABLE_arg, VALUE_arg, NONE_arg, NONE_arg
+};
+
+/*
+ * Finds the instruction spelled NAME.
+ * Is passed the text to look up and where to save the instruction.
+ * Returns false if NAME is not an instruction.
+ */
+bool findOpcode(const std::string_view NAME, Opcode& opcode)
+{
+  for(int i = 0; i < OPCODES; i++)
+  {
+    if(NAME == OPCODE_NAMES[i])
+    {
+      opcode = static_cast<Opcode>(i);
+      return true;
+    }
+  }
+  
+  return false;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+//Target language information can be found here https://comp.umsl.edu/assembler/index
+
+#ifndef ASM_H
+#define ASM_H
+
+#include <cstdint>
+#include <string_view>
+
+//Every instruction of the target language the compiler generates
+enum Opcode : uint8_t {
+  BR_op, BRNEG_op, BRZNEG_op, BRPOS_op, BRZPOS_op, BRZERO_op,
+  LOAD_op, STORE_op, ADD_op, SUB_op, MULT_op, DIV_op, READ_op, WRITE_op, NOOP_op, STOP_op,
+  OPCODES //How many instructions there are
+};
+
+//What an instruction takes as its argument
+enum Operand : uint8_t {
+  NONE_arg,     //Nothing, anything after the instruction is ignored
+  LABEL_arg,    //A label defined somewhere in the program
+  VARIABLE_arg, //A variable from the data section
+  VALUE_arg     //A variable or an integer
+};
+
+//What the argument of a generated instruction holds
+enum ArgKind : uint8_t {
+  NONE_ak,   //No argument
+  LABEL_ak,  //The number of a label, written B<number>
+  SYMBOL_ak, //The symbol ID of a variable or of a integer too big to be written as one
+  INT_ak     //A 32-bit integer
+};
+
+const uint32_t NO_LABEL = UINT32_MAX; //AsmInstr::label of a instruction without a label
+
+//A instruction of a target being generated
+struct AsmInstr {
+  Opcode op;      //The instruction
+  ArgKind kind;   //What arg holds
+  uint32_t arg;   //The label number, symbol ID or integer, integers are stored as their 32 bits
+  uint32_t label; //Number of the label defined on this instruction or NO_LABEL
+  int line;       //Source line of the statement it was made for, 0 if there is none
+};
+
+//The text of every instruction, OPCODE_NAMES[opcode]
+extern const char* const OPCODE_NAMES[OPCODES];
+
+//The argument of every instruction, OPCODE_OPERANDS[opcode]
+extern const Operand OPCODE_OPERANDS[OPCODES];
+
+/*
+ * Finds the instruction spelled NAME.
+ * Is passed the text to look up and where to save the instruction.
+ * Returns false if NAME is not an instruction.
+ */
+bool findOpcode(const std::string_view NAME, Opcode& opcode);
+
+#endif
\ No newline at end of file
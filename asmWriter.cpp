@@ -0,0 +1,96 @@
+#include <charconv>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "asmWriter.h"
+
+/*
+ * Definition: Creates or truncates FILENAME and writes DATA to it with as few write calls as the system allows, one
+ *             unless it is interrupted or only takes part of it.
+ * Passed:     The name of the file to write and what to write
+ * Returns:    False if the file could not be opened or written
+ */
+bool writeFile(const std::string& FILENAME, const std::string_view DATA)
+{
+  int fd = open(FILENAME.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if(fd < 0) return false;
+  
+  const char* next = DATA.data();
+  size_t left = DATA.size();
+  while(left > 0)
+  {
+    ssize_t written = write(fd, next, left);
+    if(written < 0)
+    {
+      if(errno == EINTR) continue;
+      close(fd);
+      return false;
+    }
+    next += written;
+    left -= written;
+  }
+  
+  return close(fd) == 0;
+}
+
+AsmWriter::AsmWriter()
+{
+  this->buffer.reserve(RESERVE);
+}
+
+/*
+ * Definition: Appends INSTR as one line, its label as B(num): before it
+ * Passed:     The instruction and the symbol table its symbols are interned in
+ */
+void AsmWriter::instr(const AsmInstr& INSTR, const SymbolTable& SYMBOLS)
+{
+  if(INSTR.label != NO_LABEL)
+  {
+    this->buffer += 'B';
+    this->appendInt(INSTR.label);
+    this->buffer += ": ";
+  }
+  this->buffer += OPCODE_NAMES[INSTR.op];
+  
+  if(INSTR.kind == LABEL_ak)
+  {
+    this->buffer += " B";
+    this->appendInt(INSTR.arg);
+  }
+  else if(INSTR.kind == SYMBOL_ak)
+  {
+    this->buffer += ' ';
+    this->buffer += SYMBOLS.text(INSTR.arg);
+  }
+  else if(INSTR.kind == INT_ak)
+  {
+    this->buffer += ' ';
+    this->appendInt(static_cast<int32_t>(INSTR.arg));
+  }
+  this->buffer += '\n';
+}
+
+//Appends the storage line of the variable NAME starting as VALUE, NAME VALUE
+void AsmWriter::variable(const std::string_view NAME, const std::string_view VALUE)
+{
+  this->buffer += NAME;
+  this->buffer += ' ';
+  this->buffer += VALUE;
+  this->buffer += '\n';
+}
+
+//Writes the whole target to out at once
+void AsmWriter::writeTo(std::ostream& out) const
+{
+  out.write(this->buffer.data(), this->buffer.size());
+}
+
+//Appends VALUE in decimal
+void AsmWriter::appendInt(const int64_t VALUE)
+{
+  char digits[24];
+  char* end = std::to_chars(digits, digits + sizeof(digits), VALUE).ptr;
+  this->buffer.append(digits, end - digits);
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef ASMWRITER_H
+#define ASMWRITER_H
+
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <cstdint>
+
+#include "asm.h"
+#include "symbols.h"
+
+/*
+ * Definition: Creates or truncates FILENAME and writes DATA to it with as few write calls as the system allows, one
+ *             unless it is interrupted or only takes part of it.
+ * Passed:     The name of the file to write and what to write
+ * Returns:    False if the file could not be opened or written
+ */
+bool writeFile(const std::string& FILENAME, const std::string_view DATA);
+
+/*
+ * Renders a target into one buffer that is kept between targets so its memory is reused. Nothing leaves the buffer
+ * until the finished target is handed to a sink: a file written with a single write, a stream or the string itself
+ * for callers that keep the target in memory.
+ */
+class AsmWriter
+{
+  private:
+    static const size_t RESERVE = 1 << 16; //Bytes the buffer starts with
+    std::string buffer;                    //The target rendered so far
+    
+    //Appends VALUE in decimal
+    void appendInt(const int64_t VALUE);
+    
+  public:
+    AsmWriter();
+    
+    //Empties the buffer for the next target, its memory is kept
+    void clear() { this->buffer.clear(); }
+    
+    /*
+     * Definition: Appends INSTR as one line, its label as B(num): before it
+     * Passed:     The instruction and the symbol table its symbols are interned in
+     */
+    void instr(const AsmInstr& INSTR, const SymbolTable& SYMBOLS);
+    
+    //Appends the storage line of the variable NAME starting as VALUE, NAME VALUE
+    void variable(const std::string_view NAME, const std::string_view VALUE);
+    
+    //Returns the target rendered so far
+    const std::string& text() const { return this->buffer; }
+    
+    //Writes the whole target to FILENAME with ::writeFile, returns false if it could not be written
+    bool writeFile(const std::string& FILENAME) const { return ::writeFile(FILENAME, this->buffer); }
+    
+    //Writes the whole target to out at once
+    void writeTo(std::ostream& out) const;
+};
+
+#endif
\ No newline at end of file
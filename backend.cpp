@@ -0,0 +1,295 @@
+#include <string>
+
+#include "backend.h"
+
+const uint32_t NO_SLOT = UINT32_MAX; //Slot of a temp that has not been saved
+
+/*
+ * Object for the target being lowered to be passed throughout the backend.
+ */
+struct LowerObj {
+  const IrProgram &program;           //The program being lowered
+  SemanticTable &table;               //Variables of the program, _(num) are added as they are made
+  std::vector<AsmInstr> &code;        //Where the target goes
+  IrArg acc;                          //What the acc holds, NONE_ia when it is not known
+  uint32_t at;                        //Instruction being lowered in its block, instrs.size() for the terminator
+  int line;                           //Source line the instructions being emitted are for
+  std::vector<uint32_t> lastUse = {}; //1 + index of the last instruction of its block using each temp, 0 if none
+  std::vector<uint32_t> slotOf = {};  //The slot each temp is saved in or NO_SLOT
+  std::vector<uint32_t> slots = {};   //Symbol ID of the _(num) of every slot
+  std::vector<char> slotBusy = {};    //If each slot holds a temp that is still to be used
+};
+
+//Instruction for every IrOp that works on the acc, IROP_OPCODES[op]
+static const Opcode IROP_OPCODES[IROPS] = { LOAD_op, MULT_op, ADD_op, SUB_op, MULT_op, DIV_op, READ_op, WRITE_op };
+
+//Branches taken when a - b in the acc passes or fails each Relation, NOOP_op for none
+static const Opcode BRANCH_TRUE[RELATIONS][2] = {
+  { BRZNEG_op, NOOP_op }, { BRNEG_op, NOOP_op }, { BRZPOS_op, NOOP_op }, { BRPOS_op, NOOP_op },
+  { BRZERO_op, NOOP_op }, { BRPOS_op, BRNEG_op }
+};
+static const Opcode BRANCH_FALSE[RELATIONS][2] = {
+  { BRPOS_op, NOOP_op }, { BRZPOS_op, NOOP_op }, { BRNEG_op, NOOP_op }, { BRZNEG_op, NOOP_op },
+  { BRPOS_op, BRNEG_op }, { BRZERO_op, NOOP_op }
+};
+
+static void lowerBlock(LowerObj& lowerObj, const uint32_t BLOCK, const bool LABELED);
+static void lowerInstr(LowerObj& lowerObj, const IrInstr& INSTR);
+static void lowerTerm(LowerObj& lowerObj, const uint32_t BLOCK);
+static void emitBranches(LowerObj& lowerObj, const Opcode BRANCHES[2], const uint32_t TARGET);
+static void loadAcc(LowerObj& lowerObj, const IrArg ARG);
+static void saveAcc(LowerObj& lowerObj);
+static void setResult(LowerObj& lowerObj, const IrArg DEST);
+static void useArg(LowerObj& lowerObj, const Opcode OP, const IrArg ARG);
+static void noteUse(LowerObj& lowerObj, const IrArg ARG, const uint32_t INDEX);
+static void freeTemp(LowerObj& lowerObj, const IrArg ARG);
+static void emit(LowerObj& lowerObj, const Opcode OP, const ArgKind KIND = NONE_ak, const uint32_t ARG = 0);
+
+
+/*
+ * Description: Lowers PROGRAM to UMSL's accumulator ASM. The backend keeps track of what the acc holds so a value
+ *              already in it is not loaded again and a temp is only saved to memory when the acc is needed for
+ *              something else while the temp is still to be used. Saved temps go into _(num) variables that are
+ *              reused once the temp is dead, a _(num) is added to the semantic table the first time it is needed.
+ *              Every block that is branched to gets the label B(block number), a branch to the next block is left out.
+ * Passed:      The program, the semantic table of the program and the list to add the instructions to.
+ */
+void lowerIr(const IrProgram& PROGRAM, SemanticTable& table, std::vector<AsmInstr>& code)
+{
+  LowerObj lowerObj = { PROGRAM, table, code, noArg(), 0, 0 };
+  lowerObj.lastUse.assign(PROGRAM.temps, 0);
+  lowerObj.slotOf.assign(PROGRAM.temps, NO_SLOT);
+  
+  //Only blocks something branches to need a label, falling into the next block needs none
+  std::vector<char> labeled(PROGRAM.blocks.size(), false);
+  for(uint32_t i = 0; i < PROGRAM.blocks.size(); i++)
+  {
+    const IrBlock& block = PROGRAM.blocks[i];
+    if(block.term == CBR_tm || (block.term == JUMP_tm && block.target != i + 1)) labeled[block.target] = true;
+    if(block.term == CBR_tm) labeled[block.other] = true;
+  }
+  
+  for(uint32_t i = 0; i < PROGRAM.blocks.size(); i++) lowerBlock(lowerObj, i, labeled[i]);
+}
+
+/*
+ * Description: Lowers BLOCK. Nothing is known about the acc at the start of a block.
+ * Passed: The target being lowered, the block and if it needs a label.
+ */
+static void lowerBlock(LowerObj& lowerObj, const uint32_t BLOCK, const bool LABELED)
+{
+  const IrBlock& block = lowerObj.program.blocks[BLOCK];
+  if(LABELED) lowerObj.code.push_back({ NOOP_op, NONE_ak, 0, BLOCK, 0 });
+  lowerObj.acc = noArg();
+  
+  //Find the last use of every temp, temps never live past their block
+  for(uint32_t i = 0; i < block.instrs.size(); i++)
+  {
+    noteUse(lowerObj, block.instrs[i].a, i);
+    noteUse(lowerObj, block.instrs[i].b, i);
+  }
+  if(block.term == CBR_tm)
+  {
+    noteUse(lowerObj, block.a, block.instrs.size());
+    noteUse(lowerObj, block.b, block.instrs.size());
+  }
+  
+  for(lowerObj.at = 0; lowerObj.at < block.instrs.size(); lowerObj.at++)
+  {
+    const IrInstr& instr = block.instrs[lowerObj.at];
+    lowerObj.line = instr.line;
+    lowerInstr(lowerObj, instr);
+    freeTemp(lowerObj, instr.a);
+    freeTemp(lowerObj, instr.b);
+  }
+  
+  lowerTerm(lowerObj, BLOCK);
+  if(block.term == CBR_tm)
+  {
+    freeTemp(lowerObj, block.a);
+    freeTemp(lowerObj, block.b);
+  }
+}
+
+/*
+ * Description: Lowers one instruction. A operator is applied to the acc when it already holds the left operand, or the
+ *              right operand of + and %. a - b with b in the acc is -(b - a) which is exact when the acc wraps.
+ * Passed: The target being lowered and the instruction.
+ */
+static void lowerInstr(LowerObj& lowerObj, const IrInstr& INSTR)
+{
+  if(INSTR.op == READ_ir)
+  {
+    if(lowerObj.acc == INSTR.dest) lowerObj.acc = noArg(); //The variable no longer holds what the acc does
+    emit(lowerObj, READ_op, SYMBOL_ak, INSTR.dest.id);
+    return;
+  }
+  if(INSTR.op == WRITE_ir)
+  {
+    useArg(lowerObj, WRITE_op, INSTR.a);
+    return;
+  }
+  
+  Opcode op = IROP_OPCODES[INSTR.op];
+  if(INSTR.op == COPY_ir)
+  {
+    loadAcc(lowerObj, INSTR.a);
+  }
+  else if(INSTR.op == NEG_ir)
+  {
+    loadAcc(lowerObj, INSTR.a);
+    emit(lowerObj, MULT_op, INT_ak, static_cast<uint32_t>(-1));
+  }
+  else if(lowerObj.acc == INSTR.a) //<acc> op b
+  {
+    useArg(lowerObj, op, INSTR.b);
+  }
+  else if(lowerObj.acc == INSTR.b && (INSTR.op == ADD_ir || INSTR.op == MULT_ir)) //a op <acc>
+  {
+    useArg(lowerObj, op, INSTR.a);
+  }
+  else if(lowerObj.acc == INSTR.b && INSTR.op == SUB_ir) //a - <acc> is -(<acc> - a)
+  {
+    useArg(lowerObj, op, INSTR.a);
+    emit(lowerObj, MULT_op, INT_ak, static_cast<uint32_t>(-1));
+  }
+  else
+  {
+    loadAcc(lowerObj, INSTR.a);
+    useArg(lowerObj, op, INSTR.b);
+  }
+  
+  setResult(lowerObj, INSTR.dest);
+}
+
+/*
+ * Description: Lowers the terminator of BLOCK. A CBR_tm works out a - b in the acc and branches on its sign, to the
+ *              target when the next block is the other one and the other way around. When neither block is next
+ *              it branches to the target and then goes to the other block with BR.
+ * Passed: The target being lowered and the block.
+ */
+static void lowerTerm(LowerObj& lowerObj, const uint32_t BLOCK)
+{
+  const IrBlock& block = lowerObj.program.blocks[BLOCK];
+  lowerObj.at = block.instrs.size();
+  lowerObj.line = block.line;
+  
+  if(block.term == STOP_tm)
+  {
+    emit(lowerObj, STOP_op);
+    return;
+  }
+  if(block.term == JUMP_tm || block.target == block.other)
+  {
+    if(block.target != BLOCK + 1) emit(lowerObj, BR_op, LABEL_ak, block.target);
+    return;
+  }
+  
+  loadAcc(lowerObj, block.a);
+  useArg(lowerObj, SUB_op, block.b);
+  lowerObj.acc = noArg();
+  
+  if(block.other == BLOCK + 1)
+  {
+    emitBranches(lowerObj, BRANCH_TRUE[block.rel], block.target);
+  }
+  else if(block.target == BLOCK + 1)
+  {
+    emitBranches(lowerObj, BRANCH_FALSE[block.rel], block.other);
+  }
+  else
+  {
+    emitBranches(lowerObj, BRANCH_TRUE[block.rel], block.target);
+    emit(lowerObj, BR_op, LABEL_ak, block.other);
+  }
+}
+
+//Description: Adds the branches in BRANCHES that are not NOOP_op going to block TARGET
+static void emitBranches(LowerObj& lowerObj, const Opcode BRANCHES[2], const uint32_t TARGET)
+{
+  for(int i = 0; i < 2; i++)
+  {
+    if(BRANCHES[i] != NOOP_op) emit(lowerObj, BRANCHES[i], LABEL_ak, TARGET);
+  }
+}
+
+//Description: Makes the acc hold ARG, saving the temp it holds first if that temp is still to be used
+static void loadAcc(LowerObj& lowerObj, const IrArg ARG)
+{
+  if(lowerObj.acc == ARG) return;
+  
+  saveAcc(lowerObj);
+  useArg(lowerObj, LOAD_op, ARG);
+  lowerObj.acc = ARG;
+}
+
+/*
+ * Description: Saves the temp in the acc to the first free _(num) if it is used by this instruction or a later one
+ *              and has not been saved yet. A new _(num) is added to the semantic table when every one is busy.
+ */
+static void saveAcc(LowerObj& lowerObj)
+{
+  if(lowerObj.acc.kind != TEMP_ia) return;
+  uint32_t temp = lowerObj.acc.id;
+  if(lowerObj.slotOf[temp] != NO_SLOT || lowerObj.lastUse[temp] <= lowerObj.at) return;
+  
+  uint32_t slot = 0;
+  while(slot < lowerObj.slots.size() && lowerObj.slotBusy[slot]) slot++;
+  if(slot == lowerObj.slots.size())
+  {
+    uint32_t symbol = lowerObj.table.symbolTable().intern("_" + std::to_string(slot));
+    lowerObj.table.insert(symbol, -1);
+    lowerObj.slots.push_back(symbol);
+    lowerObj.slotBusy.push_back(false);
+  }
+  
+  lowerObj.slotBusy[slot] = true;
+  lowerObj.slotOf[temp] = slot;
+  emit(lowerObj, STORE_op, SYMBOL_ak, lowerObj.slots[slot]);
+}
+
+//Description: Records that the acc holds the result of the instruction and stores it when DEST is a variable
+static void setResult(LowerObj& lowerObj, const IrArg DEST)
+{
+  if(DEST.kind == SYMBOL_ia) emit(lowerObj, STORE_op, SYMBOL_ak, DEST.id);
+  lowerObj.acc = DEST;
+}
+
+//Description: Adds OP with ARG as its argument, a temp is used from its _(num) which it is saved to first if needed
+static void useArg(LowerObj& lowerObj, const Opcode OP, const IrArg ARG)
+{
+  if(ARG.kind == TEMP_ia)
+  {
+    if(lowerObj.slotOf[ARG.id] == NO_SLOT) saveAcc(lowerObj); //Only the temp in the acc is not saved
+    emit(lowerObj, OP, SYMBOL_ak, lowerObj.slots[lowerObj.slotOf[ARG.id]]);
+  }
+  else if(ARG.kind == SYMBOL_ia)
+  {
+    emit(lowerObj, OP, SYMBOL_ak, ARG.id);
+  }
+  else
+  {
+    emit(lowerObj, OP, INT_ak, ARG.id);
+  }
+}
+
+//Description: Records that the instruction at INDEX uses ARG if it is a temp
+static void noteUse(LowerObj& lowerObj, const IrArg ARG, const uint32_t INDEX)
+{
+  if(ARG.kind == TEMP_ia) lowerObj.lastUse[ARG.id] = INDEX + 1;
+}
+
+//Description: Frees the _(num) of ARG if it is a temp this was the last use of
+static void freeTemp(LowerObj& lowerObj, const IrArg ARG)
+{
+  if(ARG.kind != TEMP_ia || lowerObj.lastUse[ARG.id] != lowerObj.at + 1) return;
+  
+  uint32_t slot = lowerObj.slotOf[ARG.id];
+  if(slot != NO_SLOT) lowerObj.slotBusy[slot] = false;
+}
+
+//Description: Adds the instruction OP with ARG of KIND as its argument, made for the line being lowered
+static void emit(LowerObj& lowerObj, const Opcode OP, const ArgKind KIND, const uint32_t ARG)
+{
+  lowerObj.code.push_back({ OP, KIND, ARG, NO_LABEL, lowerObj.line });
+}
\ No newline at end of file
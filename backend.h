@@ -0,0 +1,20 @@
+#ifndef BACKEND_H
+#define BACKEND_H
+
+#include <vector>
+
+#include "asm.h"
+#include "ir.h"
+#include "statSem.h"
+
+/*
+ * Description: Lowers PROGRAM to UMSL's accumulator ASM. The backend keeps track of what the acc holds so a value
+ *              already in it is not loaded again and a temp is only saved to memory when the acc is needed for
+ *              something else while the temp is still to be used. Saved temps go into _(num) variables that are
+ *              reused once the temp is dead, a _(num) is added to the semantic table the first time it is needed.
+ *              Every block that is branched to gets the label B(block number), a branch to the next block is left out.
+ * Passed:      The program, the semantic table of the program and the list to add the instructions to.
+ */
+void lowerIr(const IrProgram& PROGRAM, SemanticTable& table, std::vector<AsmInstr>& code);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "batch.h"
+#include "compiler.h"
+#include "threadPool.h"
+
+static const std::string EXTENSION = ".4280fs24"; //Every input program ends with this
+
+static std::vector<std::string> listSources(const std::string SOURCES);
+static bool hasExtension(const std::string& FILENAME);
+
+/*
+ *  Description: Compiles every program named by SOURCES at the same time on a work stealing pool (threadPool.h).
+ *               SOURCES is either a directory, every .4280fs24 file in it is compiled, or a list file with the path
+ *               of one .4280fs24 file per line. Each program is saved next to its source as name.asm.
+ *               Once every program is done the messages of each one are printed to out in the order the files
+ *               were listed, directories are listed by name. Throws a invalid_argument error if SOURCES can not be read.
+ *  Passed:      The directory or list file SOURCES, the stream out to print the messages to and the OPTIONS
+ *               every program is compiled with.
+ *  Returns:     True if every program compiled.
+ */
+bool compileBatch(const std::string SOURCES, std::ostream& out, const CompileOptions OPTIONS)
+{
+  std::vector<std::string> files = listSources(SOURCES);
+  std::vector<std::string> messages(files.size()); //Everything each compile printed
+  std::vector<char> success(files.size(), false);  //Status of each compile
+  
+  //Every job only touches its own file, messages and status
+  ThreadPool pool;
+  pool.run(files.size(), [&](size_t job)
+  {
+    const std::string& file = files[job];
+    std::ostringstream diag;
+    bool status = false;
+    
+    if(!hasExtension(file))
+    {
+      diag << "File must end with extension .4280fs24!" << std::endl;
+    }
+    else
+    {
+      try
+      {
+        status = compile(file, file.substr(0, file.size() - EXTENSION.size()), diag, OPTIONS);
+      }
+      catch(const std::invalid_argument &e) //Input file could not be opened
+      {
+        diag << "File does not exist!" << std::endl;
+      }
+    }
+    
+    diag << (status ? "Compilation Success" : "Compilation Failure") << std::endl;
+    messages[job] = diag.str();
+    success[job] = status;
+  });
+  
+  //Print in the order the files were listed no matter which finished first
+  size_t failures = 0;
+  for(size_t i = 0; i < files.size(); i++)
+  {
+    out << "== " << files[i] << std::endl << messages[i];
+    if(!success[i]) failures++;
+  }
+  out << files.size() - failures << " of " << files.size() << " files compiled" << std::endl;
+  
+  return failures == 0;
+}
+
+/*
+ *  Description: Finds the programs to compile. For a directory every .4280fs24 file in it sorted by name,
+ *               otherwise every non empty line of the list file SOURCES.
+ *               Throws a invalid_argument error if SOURCES can not be read.
+ *  Passed:      The directory or list file SOURCES
+ *  Returns:     The paths of the programs
+ */
+static std::vector<std::string> listSources(const std::string SOURCES)
+{
+  std::vector<std::string> files;
+  std::error_code error;
+  
+  if(std::filesystem::is_directory(SOURCES, error))
+  {
+    for(std::filesystem::directory_iterator entry(SOURCES, error), end; !error && entry != end; entry.increment(error))
+    {
+      std::string path = entry->path().string();
+      if(entry->is_regular_file() && hasExtension(path)) files.push_back(path);
+    }
+    if(error) throw std::invalid_argument("ERROR: Could not read directory " + SOURCES);
+    
+    std::sort(files.begin(), files.end());
+    return files;
+  }
+  
+  std::ifstream list(SOURCES.c_str());
+  if(list.fail()) throw std::invalid_argument("ERROR: Could not open batch list " + SOURCES);
+  
+  std::string line;
+  while(std::getline(list, line))
+  {
+    if(!line.empty()) files.push_back(line);
+  }
+  
+  return files;
+}
+
+//Checks if FILENAME ends with .4280fs24 and has a name before it
+static bool hasExtension(const std::string& FILENAME)
+{
+  return FILENAME.size() > EXTENSION.size() && FILENAME.compare(FILENAME.size() - EXTENSION.size(), EXTENSION.size(), EXTENSION) == 0;
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <string>
+#include <ostream>
+
+#include "compiler.h"
+
+/*
+ *  Description: Compiles every program named by SOURCES at the same time on a work stealing pool (threadPool.h).
+ *               SOURCES is either a directory, every .4280fs24 file in it is compiled, or a list file with the path
+ *               of one .4280fs24 file per line. Each program is saved next to its source as name.asm.
+ *               Once every program is done the messages of each one are printed to out in the order the files
+ *               were listed, directories are listed by name. Throws a invalid_argument error if SOURCES can not be read.
+ *  Passed:      The directory or list file SOURCES, the stream out to print the messages to and the OPTIONS
+ *               every program is compiled with.
+ *  Returns:     True if every program compiled.
+ */
+bool compileBatch(const std::string SOURCES, std::ostream& out, const CompileOptions OPTIONS = CompileOptions());
+
+#endif
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include <vector>
+
+#include "cfg.h"
+
+static bool removeDeadStores(IrProgram& program, CfgReport& report);
+static bool foldBranches(IrProgram& program, CfgReport& report);
+static bool threadJumps(IrProgram& program, CfgReport& report);
+static bool mergeBlocks(IrProgram& program, CfgReport& report);
+static bool removeUnreachable(IrProgram& program, CfgReport& report);
+static uint32_t skipEmpty(const IrProgram& PROGRAM, uint32_t block);
+static void countUses(const IrArg& ARG, std::vector<uint32_t>& symbolReads, std::vector<uint32_t>& tempUses);
+
+/*
+ * Description: Simplifies the control flow graph of PROGRAM, the blocks and the terminators that link them:
+ *              - instructions setting a variable nothing reads, or a temp nothing uses, are removed. A division
+ *                that could fault is kept so the program still faults.
+ *              - a branch whose test is known at compile time becomes a goto.
+ *              - a branch to a empty block that only does goto X goes to X.
+ *              - a block that only one block goes to with a goto is joined onto the end of it.
+ *              - blocks that can not be reached from block 0 are removed.
+ *              These run again until nothing changes. The blocks left keep their order.
+ *              A report can be passed to more than one run, the counts add up.
+ * Passed:      The program and the report to count what was done in.
+ */
+void simplifyCfg(IrProgram& program, CfgReport& report)
+{
+  if(report.runs++ == 0)
+  {
+    report.blocksBefore = program.blocks.size();
+    report.instrsBefore = irSize(program);
+  }
+  
+  bool changed = true;
+  while(changed)
+  {
+    changed = removeDeadStores(program, report);
+    changed |= foldBranches(program, report);
+    changed |= threadJumps(program, report);
+    changed |= removeUnreachable(program, report);
+    changed |= mergeBlocks(program, report);
+  }
+  
+  report.blocksAfter = program.blocks.size();
+  report.instrsAfter = irSize(program);
+}
+
+//Prints how many blocks and instructions simplifyCfg removed and what it did to out
+void printReport(const CfgReport& REPORT, std::ostream& out)
+{
+  out << "CFG: " << REPORT.blocksBefore << " -> " << REPORT.blocksAfter << " blocks, "
+      << REPORT.instrsBefore << " -> " << REPORT.instrsAfter << " instructions" << std::endl;
+  out << "  folded branches    " << REPORT.folded << std::endl;
+  out << "  threaded jumps     " << REPORT.threaded << std::endl;
+  out << "  merged blocks      " << REPORT.merged << std::endl;
+  out << "  unreachable blocks " << REPORT.unreachable << std::endl;
+  out << "  dead stores        " << REPORT.deadStores << std::endl;
+}
+
+/*
+ * Description: Removes every instruction that sets a variable no instruction or test of the program reads, or a temp
+ *              nothing uses. Reading a variable still happens since it takes input. Runs until nothing is removed
+ *              since removing a instruction can leave what it read unused.
+ * Passed:      The program and the report to count in.
+ * Returns:     True if anything was removed.
+ */
+static bool removeDeadStores(IrProgram& program, CfgReport& report)
+{
+  bool changed = false;
+  bool removed = true;
+  while(removed)
+  {
+    removed = false;
+    
+    //How many times every symbol is read and every temp is used
+    uint32_t symbols = 0;
+    for(const IrBlock& block : program.blocks)
+    {
+      for(const IrInstr& instr : block.instrs)
+      {
+        if(instr.dest.kind == SYMBOL_ia && instr.dest.id >= symbols) symbols = instr.dest.id + 1;
+        if(instr.a.kind == SYMBOL_ia && instr.a.id >= symbols) symbols = instr.a.id + 1;
+        if(instr.b.kind == SYMBOL_ia && instr.b.id >= symbols) symbols = instr.b.id + 1;
+      }
+      if(block.term == CBR_tm && block.a.kind == SYMBOL_ia && block.a.id >= symbols) symbols = block.a.id + 1;
+      if(block.term == CBR_tm && block.b.kind == SYMBOL_ia && block.b.id >= symbols) symbols = block.b.id + 1;
+    }
+    std::vector<uint32_t> symbolReads(symbols, 0);
+    std::vector<uint32_t> tempUses(program.temps, 0);
+    for(const IrBlock& block : program.blocks)
+    {
+      for(const IrInstr& instr : block.instrs)
+      {
+        countUses(instr.a, symbolReads, tempUses);
+        countUses(instr.b, symbolReads, tempUses);
+      }
+      if(block.term == CBR_tm)
+      {
+        countUses(block.a, symbolReads, tempUses);
+        countUses(block.b, symbolReads, tempUses);
+      }
+    }
+    
+    for(IrBlock& block : program.blocks)
+    {
+      size_t kept = 0;
+      for(size_t i = 0; i < block.instrs.size(); i++)
+      {
+        const IrInstr& instr = block.instrs[i];
+        bool dead = instr.op != READ_ir && instr.op != WRITE_ir && !canFault(instr) &&
+                    ((instr.dest.kind == SYMBOL_ia && symbolReads[instr.dest.id] == 0) ||
+                     (instr.dest.kind == TEMP_ia && tempUses[instr.dest.id] == 0));
+        if(dead)
+        {
+          report.deadStores++;
+          removed = true;
+        }
+        else
+        {
+          block.instrs[kept++] = instr;
+        }
+      }
+      block.instrs.resize(kept);
+    }
+    changed |= removed;
+  }
+  
+  return changed;
+}
+
+/*
+ * Description: Turns every branch whose test is known into a goto. The test is known when both sides are integers
+ *              or both are the same variable or temp, or when both ways go to the same block.
+ * Passed:      The program and the report to count in.
+ * Returns:     True if any branch was folded.
+ */
+static bool foldBranches(IrProgram& program, CfgReport& report)
+{
+  bool changed = false;
+  for(IrBlock& block : program.blocks)
+  {
+    if(block.term != CBR_tm) continue;
+    
+    bool known = true;
+    int32_t difference = 0;
+    if(block.a.kind == INT_ia && block.b.kind == INT_ia) difference = static_cast<int32_t>(block.a.id - block.b.id); //Wraps like the target
+    else if(block.a == block.b) difference = 0;
+    else known = block.target == block.other;
+    if(!known) continue;
+    
+    if(!testHolds(block.rel, difference)) block.target = block.other;
+    block.term = JUMP_tm;
+    report.folded++;
+    changed = true;
+  }
+  
+  return changed;
+}
+
+/*
+ * Description: Sends every goto and branch to a empty block that only does goto X straight to X.
+ * Passed:      The program and the report to count in.
+ * Returns:     True if any branch was changed.
+ */
+static bool threadJumps(IrProgram& program, CfgReport& report)
+{
+  bool changed = false;
+  for(IrBlock& block : program.blocks)
+  {
+    uint32_t target = skipEmpty(program, block.target);
+    if(block.term != STOP_tm && target != block.target)
+    {
+      block.target = target;
+      report.threaded++;
+      changed = true;
+    }
+    
+    uint32_t other = skipEmpty(program, block.other);
+    if(block.term == CBR_tm && other != block.other)
+    {
+      block.other = other;
+      report.threaded++;
+      changed = true;
+    }
+  }
+  
+  return changed;
+}
+
+/*
+ * Description: Joins a block onto the block before it in control flow when that block goes to it with a goto and
+ *              nothing else goes to it. The joined block is left with nothing going to it for removeUnreachable.
+ * Passed:      The program and the report to count in.
+ * Returns:     True if any block was joined.
+ */
+static bool mergeBlocks(IrProgram& program, CfgReport& report)
+{
+  //How many terminators go to every block
+  std::vector<uint32_t> preds(program.blocks.size(), 0);
+  for(const IrBlock& block : program.blocks)
+  {
+    if(block.term == JUMP_tm) preds[block.target]++;
+    if(block.term == CBR_tm)
+    {
+      preds[block.target]++;
+      preds[block.other]++;
+    }
+  }
+  
+  bool changed = false;
+  std::vector<char> joined(program.blocks.size(), false);
+  for(uint32_t i = 0; i < program.blocks.size(); i++)
+  {
+    IrBlock& block = program.blocks[i];
+    if(joined[i]) continue;
+    
+    while(block.term == JUMP_tm && block.target != i && block.target != 0 && preds[block.target] == 1)
+    {
+      uint32_t next = block.target;
+      IrBlock& nextBlock = program.blocks[next];
+      block.instrs.insert(block.instrs.end(), nextBlock.instrs.begin(), nextBlock.instrs.end());
+      block.term = nextBlock.term;
+      block.rel = nextBlock.rel;
+      block.a = nextBlock.a;
+      block.b = nextBlock.b;
+      block.target = nextBlock.target;
+      block.other = nextBlock.other;
+      block.line = nextBlock.line;
+      
+      //Nothing goes to the joined block anymore, it goes nowhere
+      nextBlock.instrs.clear();
+      nextBlock.term = JUMP_tm;
+      nextBlock.target = next;
+      joined[next] = true;
+      
+      report.merged++;
+      changed = true;
+    }
+  }
+  
+  return changed;
+}
+
+/*
+ * Description: Removes every block that can not be reached from block 0 and numbers the blocks left in order.
+ * Passed:      The program and the report to count in.
+ * Returns:     True if any block was removed.
+ */
+static bool removeUnreachable(IrProgram& program, CfgReport& report)
+{
+  std::vector<char> reached(program.blocks.size(), false);
+  std::vector<uint32_t> stack(1, 0);
+  reached[0] = true;
+  while(!stack.empty())
+  {
+    const IrBlock& block = program.blocks[stack.back()];
+    stack.pop_back();
+    
+    if(block.term != STOP_tm && !reached[block.target])
+    {
+      reached[block.target] = true;
+      stack.push_back(block.target);
+    }
+    if(block.term == CBR_tm && !reached[block.other])
+    {
+      reached[block.other] = true;
+      stack.push_back(block.other);
+    }
+  }
+  
+  //New number of every block that is kept
+  std::vector<uint32_t> number(program.blocks.size(), 0);
+  uint32_t kept = 0;
+  for(uint32_t i = 0; i < program.blocks.size(); i++)
+  {
+    if(reached[i]) number[i] = kept++;
+  }
+  if(kept == program.blocks.size()) return false;
+  
+  report.unreachable += program.blocks.size() - kept;
+  for(uint32_t i = 0; i < program.blocks.size(); i++)
+  {
+    if(!reached[i]) continue;
+    
+    IrBlock& block = program.blocks[i];
+    block.target = number[block.target];
+    block.other = number[block.other];
+    if(number[i] != i) program.blocks[number[i]] = std::move(block);
+  }
+  program.blocks.resize(kept);
+  
+  return true;
+}
+
+//Returns where going to block ends up after skipping empty blocks that only do goto, a loop of them is not skipped
+static uint32_t skipEmpty(const IrProgram& PROGRAM, uint32_t block)
+{
+  for(size_t steps = 0; steps < PROGRAM.blocks.size(); steps++)
+  {
+    const IrBlock& next = PROGRAM.blocks[block];
+    if(!next.instrs.empty() || next.term != JUMP_tm || next.target == block) return block;
+    block = next.target;
+  }
+  
+  return block;
+}
+
+//Counts a read of ARG if it is a symbol or temp
+static void countUses(const IrArg& ARG, std::vector<uint32_t>& symbolReads, std::vector<uint32_t>& tempUses)
+{
+  if(ARG.kind == SYMBOL_ia) symbolReads[ARG.id]++;
+  else if(ARG.kind == TEMP_ia) tempUses[ARG.id]++;
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef CFG_H
+#define CFG_H
+
+#include <cstdint>
+#include <ostream>
+
+#include "ir.h"
+
+//What simplifyCfg did
+struct CfgReport {
+  uint32_t runs = 0;        //Times simplifyCfg ran with this report
+  size_t blocksBefore = 0;  //Blocks before the first simplifyCfg
+  size_t blocksAfter = 0;   //Blocks after the last simplifyCfg
+  size_t instrsBefore = 0;  //Instructions before the first simplifyCfg counting terminators (irSize)
+  size_t instrsAfter = 0;   //Instructions after the last simplifyCfg
+  uint32_t folded = 0;      //Branches whose test was known and became a goto
+  uint32_t threaded = 0;    //Branches sent past a empty block that only goes somewhere else
+  uint32_t merged = 0;      //Blocks joined onto the only block that goes to them
+  uint32_t unreachable = 0; //Blocks removed since nothing goes to them
+  uint32_t deadStores = 0;  //Instructions removed since nothing reads what they set
+};
+
+/*
+ * Description: Simplifies the control flow graph of PROGRAM, the blocks and the terminators that link them:
+ *              - instructions setting a variable nothing reads, or a temp nothing uses, are removed. A division
+ *                that could fault is kept so the program still faults.
+ *              - a branch whose test is known at compile time becomes a goto.
+ *              - a branch to a empty block that only does goto X goes to X.
+ *              - a block that only one block goes to with a goto is joined onto the end of it.
+ *              - blocks that can not be reached from block 0 are removed.
+ *              These run again until nothing changes. The blocks left keep their order.
+ *              A report can be passed to more than one run, the counts add up.
+ * Passed:      The program and the report to count what was done in.
+ */
+void simplifyCfg(IrProgram& program, CfgReport& report);
+
+//Prints how many blocks and instructions simplifyCfg removed and what it did to out
+void printReport(const CfgReport& REPORT, std::ostream& out);
+
+#endif
\ No newline at end of file
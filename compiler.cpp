@@ -1,422 +1,249 @@
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 #include "compiler.h"
 #include "tree.h"
+#include "source.h"
+#include "scanner.h"
+#include "lexer.h"
+#include "pipeline.h"
 #include "parser.h"
 #include "statSem.h"
+#include "ir.h"
+#include "irGen.h"
+#include "propagate.h"
+#include "cfg.h"
+#include "loop.h"
+#include "backend.h"
+#include "peephole.h"
+#include "object.h"
+#include "vm.h"
 
-static void genTarget(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut);
+static void writeTarget(const std::vector<AsmInstr>& CODE, const SymbolTable& SYMBOLS, AsmWriter& target);
 
-//Conditional and iteration
-static void cond(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut);
-static void iter(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut);
-static std::string getRelationString(const std::string relatOp, const std::string label);
-
-//Expression nodes
-static void handleExp(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut);
-static void M(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut);
-static void N(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut);
-static void R(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut);
-
-static std::string genTempVar(std::unique_ptr<SemanticTable>& table);
-static std::string genBranchLabel();
 
+CompilerSession::CompilerSession(std::ostream& diag, const CompileOptions OPTIONS)
+  : diag(diag), options(OPTIONS) {}
 
 /*
- *  Description: This function parses a given FILENAME and saves it as BUILDNAME.asm if given a string other than "" otherwise a.asm.
- *               FILENAME needs to have /n at the end of each line to count lines. FILENAME is then run through parser for a parse tree.
- *               If there is any chracters not in the grammer or bad code structure a error is printed to the screen and returns false.
- *               Static semantics are then run on the parse tree. If static semantics fail a error is printed to the screen return false.
- *               A target is then generated from the confirmed good file. The target is generated in UMSL's ASM interpreter langauge.
- *  Passed:      A string FILENAME to read from. A string BUILDNAME to save as. If BUILDNAME is empty default is a.asm.
- *  Returns:     The status of the parse.
+ *  Description: Compiles the program in SOURCE and renders the target into target, which is cleared first.
+ *               SOURCE is treated as if it ends with a newline, one is added when it is missing. Errors and warnings
+ *               are printed to the diag stream of the session. The tree is lowered to three address code (ir.h)
+ *               which is checked, has known values propagated (propagate.h) unless the options turn folding off,
+ *               its control flow simplified (cfg.h), its loops optimized (loop.h) and is simplified and checked
+ *               again before it is lowered to a instruction list (backend.h), cleaned up by the peephole rules of
+ *               the session options (peephole.h) and rendered (asmWriter.h). Everything the compile needs lives in
+ *               this call so any number of programs can be compiled one after another or at the same time on
+ *               different sessions.
+ *  Passed:      The program SOURCE, the writer to render the target into, the stream irOut to print the
+ *               three address code to and the string objectOut to append the binary object to. Nothing is
+ *               printed or appended when they are null.
+ *  Returns:     The status of the compile. target is left empty when it fails.
  */
-bool compile(const std::string FILENAME, const std::string BUILDNAME)
+bool CompilerSession::compileBuffer(const std::string_view SOURCE, AsmWriter& target, std::ostream* irOut,
+                                    std::string* objectOut)
 {
-  //Check input program and build parse tree (parser.h)
-  std::unique_ptr<Node> parseRoot = parser(FILENAME); 
-  if(parseRoot == nullptr)
+  target.clear();
+  
+  //Every line of a program ends with a newline, give the last line one if it is missing
+  std::string_view source = SOURCE;
+  std::string terminated;
+  if(!source.empty() && source.back() != '\n')
   {
-    std::cout << "ERROR Parse Failure" << std::endl;
-    return false;
+    terminated.reserve(source.size() + 1);
+    terminated.append(source);
+    terminated.push_back('\n');
+    source = terminated;
   }
   
-  //Check Semantics and build semantic table
-  std::unique_ptr<SemanticTable> semTable = buildTable(parseRoot);
-  if(semTable == nullptr)
+  //Every token is interned in symbols (symbols.h). On more than one thread the whole program is scanned up front in
+  //chunks (lexer.h) and the parser reads the tokens from the stream, pipelined it is scanned on a thread of its own
+  //while the parser reads the tokens (pipeline.h). Chunks come first, main refuses asking for both
+  SymbolTable symbols;
+  ScannerIn scannerIn(source.data(), source.data() + source.size(), symbols, this->options.scanner);
+  TokenStream stream;
+  std::unique_ptr<ScanPipeline> pipeline;
+  if(this->options.lexThreads != 1)
   {
-    std::cout << "ERROR Static Semantics Failure" << std::endl;
-    return false;
+    lexChunks(source.data(), source.data() + source.size(), symbols, this->options.scanner, this->options.lexThreads,
+              stream);
+    scannerIn.stream = &stream;
   }
+  else if(this->options.pipeline) pipeline = std::make_unique<ScanPipeline>(scannerIn);
   
-  //Create and open the target file
-  std::string buildName = "a.asm";
-  if(!BUILDNAME.empty()) buildName = BUILDNAME + ".asm";
-  std::ofstream fileOut(buildName.c_str());
-  if (!fileOut.is_open()) 
+  //Check input program and build parse tree (parser.h). The symbols are only read once the pipeline stopped interning
+  Tree tree;
+  NodeId parseRoot = parser(scannerIn, tree, this->diag, this->options.parser);
+  if(pipeline != nullptr) pipeline->stop();
+  if(parseRoot == NO_NODE)
   {
-    std::cout << "Failed to open build file!" << std::endl;
+    this->diag << "ERROR Parse Failure" << std::endl;
     return false;
   }
   
-  //Generate the targets code
-  genTarget(parseRoot, semTable, fileOut);
-  fileOut << "STOP" << std::endl;
-  semTable->tableOut(fileOut);
-  
-  fileOut.close();
-  
-  return true;
-}
-
-/*
- * Description: Prints to the target file the conversion of the input language recursively. Generates in UMSL ASM interperter language.
- *              Nodes are expected to have the child(1|2|3|4) be in order of appearnce for that specific node based on the BNF.
- * Passed:      NODE -> root of the parse tree | table -> the semantic table | fileOut -> output filestream already opened
- */
-static void genTarget(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut) 
-{
-  if(NODE == nullptr) return;
-  
-  //<program> -> program <vars> <block>
-  if(NODE->label == "program") //NO CODE GEN
-  {
-    //We don't care about vars here that was handled when making the semantic table
-    genTarget(NODE->child2, table, fileOut);
-    return;
-  }
-  //<stats> -> <stat> <mStat>
-  else if(NODE->label == "stats") //NO CODE GEN
-  {
-    genTarget(NODE->child1, table, fileOut); //<stat>
-    genTarget(NODE->child2, table, fileOut); //<mstat>
-    return;
-  }
-  //<mStat> -> empty | <stat> <mStat>
-  else if(NODE->label == "mstat") //No CODE GEN
-  {
-    genTarget(NODE->child1, table, fileOut); //<stat>
-    genTarget(NODE->child2, table, fileOut); //<mstat>
-    return;
-  }
-  //<stat> -> <read> | <print> | <block> | <cond> | <iter> | <assign>
-  else if(NODE->label == "stat") //NO CODE GEN
-  {
-    genTarget(NODE->child1, table, fileOut); //<read> | <print> | <block> | <cond> | <iter> | <assign>
-    return;
-  }
-  //<block> -> start <vars> <stats> stop
-  else if(NODE->label == "block") //NO CODE GEN
-  {
-    //We don't care about vars here that was handled when making the semantic table
-    genTarget(NODE->child2, table, fileOut); //<stats>
-    return;
-  }
-  //<read> -> read identifier ;
-  else if(NODE->label == "read")
+  //Check Semantics and build semantic table
+  std::unique_ptr<SemanticTable> semTable = buildTable(tree, parseRoot, symbols, this->diag);
+  if(semTable == nullptr)
   {
-    fileOut << "READ " << NODE->tokens[0].instance << std::endl;
-    return;
+    this->diag << "ERROR Static Semantics Failure" << std::endl;
+    return false;
   }
-  //<print> -> print <exp> ;
-  else if(NODE->label == "print")
+  
+  //Lower the tree to three address code (ir.h), propagate what is known (propagate.h), simplify its control flow
+  //(cfg.h) and optimize its loops (loop.h)
+  IrProgram ir = genIr(tree, parseRoot, symbols, this->options.fold);
+  std::string irError = verifyIr(ir, symbols);
+  PropagateReport propagateReport;
+  CfgReport cfgReport;
+  LoopReport loopReport;
+  if(irError.empty())
   {
-    genTarget(NODE->child1, table, fileOut); //<exp>
-    std::string tempVar = genTempVar(table);
-    fileOut << "STORE " << tempVar << std::endl;
-    fileOut << "WRITE " << tempVar << std::endl;
-    return;
+    if(this->options.fold) propagateConstants(ir, *semTable, propagateReport);
+    simplifyCfg(ir, cfgReport);
+    irError = verifyIr(ir, symbols);
   }
-  else if(NODE->label == "cond")
+  if(irError.empty())
   {
-    cond(NODE, table, fileOut);
-    return;
+    optimizeLoops(ir, *semTable, loopReport);
+    simplifyCfg(ir, cfgReport);
+    irError = verifyIr(ir, symbols);
   }
-  else if(NODE->label == "iter")
+  if(!irError.empty())
   {
-    iter(NODE, table, fileOut);
-    return;
+    this->diag << "ERROR Bad IR: " << irError << std::endl;
+    return false;
   }
-  //<assign> -> set identifier <exp> ;
-  else if(NODE->label == "assign")
+  if(irOut != nullptr) printIr(ir, symbols, *irOut);
+  
+  //Generate the targets code (backend.h) and clean it up (peephole.h)
+  std::vector<AsmInstr> code;
+  lowerIr(ir, *semTable, code);
+  
+  PeepholeReport report;
+  peephole(code, this->options.peepholeRules, report);
+  if(this->options.optReport)
   {
-    genTarget(NODE->child1, table, fileOut); //<exp>
-    fileOut << "STORE " << NODE->tokens[0].instance << std::endl;
-    return;
+    printReport(propagateReport, this->diag);
+    printReport(cfgReport, this->diag);
+    printReport(loopReport, this->diag);
+    printReport(report, this->diag);
   }
-  else if(NODE->label == "exp")
+  
+  writeTarget(code, symbols, target);
+  semTable->tableOut(target);
+  
+  //The object is the target as the interpreter decodes it (vm.h), every line of the text is one instruction of code
+  //so the source line each one was made for goes with it
+  if(objectOut != nullptr)
   {
-    handleExp(NODE, table, fileOut);
-    return;
+    Program program = loadProgram(target.text());
+    program.lines.reserve(code.size());
+    for(const AsmInstr& instr : code) program.lines.push_back(instr.line);
+    writeObject(program, *objectOut);
   }
   
-  //If we get here someone broke the parser
-  std::cout << "SOMEONE BROKE THE PARSER NODE LABEL IS: " << NODE->label << std::endl;
+  return true;
 }
 
-
-
-/////////////////////////conditional + iteration/////////////////////////////////////////////
-/* Description: Handles <cond> and creates a c style if wihout else. If the condition in the loop is correct we don't skip.           
- * Passed: NODE -> the <expr> node in the tree | table -> the semantic table to add temps to |
- *                 fileOut -> output filestream already opened
- * <cond> -> iff [ <exp> <relational> <exp> ] <stat>
+/*
+ *  Description: Compiles the program in SOURCE into the writer of the session and writes the finished target to
+ *               out at once.
+ *  Passed:      The program SOURCE, the stream out to write the target to and the stream irOut to print the
+ *               three address code to, nothing is printed when it is null.
+ *  Returns:     The status of the compile. Nothing is written to out when it fails.
  */
-static void cond(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut)
+bool CompilerSession::compileBuffer(const std::string_view SOURCE, std::ostream& out, std::ostream* irOut)
 {
-  genTarget(NODE->child3, table, fileOut); //right <exp>
-  std::string tempVarRight = genTempVar(table);
-  fileOut << "STORE " << tempVarRight << std::endl;
-  
-  genTarget(NODE->child1, table, fileOut); //left <exp> saved in acc
+  if(!this->compileBuffer(SOURCE, this->writer, irOut)) return false;
   
-  std::string branchLabel = genBranchLabel();
-  std::string branchCode = getRelationString(NODE->child2->tokens[0].tokenId, branchLabel); //Get the realtional token name
-  
-  fileOut << "SUB " << tempVarRight << std::endl;
-  fileOut << branchCode << std::endl;
-  
-  genTarget(NODE->child4, table, fileOut); //<stat>
-  
-  fileOut << branchLabel << ": NOOP" << std::endl;
-
+  this->writer.writeTo(out);
+  return true;
 }
 
-/* Description: Handles <iter> and creates a c style while loop. Creates a branch to return at the top. If the condition 
- *              in the loop is correct we don't skip.               
- * Passed: NODE -> the <expr> node in the tree | table -> the semantic table to add temps to |
- *                 fileOut -> output filestream already opened
- * <iter> -> iterate [ <exp> <relational> <exp> ] <stat>
+/*
+ *  Description: Compiles SOURCE to out with a new session that prints to cout. See CompilerSession::compileBuffer.
+ *  Passed:      The program SOURCE and the stream out to write the target to.
+ *  Returns:     The status of the compile.
  */
-static void iter(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut)
+bool compileBuffer(const std::string_view SOURCE, std::ostream& out)
 {
-  std::string topBranchLabel = genBranchLabel();
-  fileOut << topBranchLabel << ": NOOP" << std::endl;
-  
-  genTarget(NODE->child3, table, fileOut); //right <exp>
-  std::string tempVarRight = genTempVar(table);
-  fileOut << "STORE " << tempVarRight << std::endl;
-  
-  genTarget(NODE->child1, table, fileOut); //left <exp> saved in acc
-  
-  std::string condBranchLabel = genBranchLabel();
-  std::string branchCode = getRelationString(NODE->child2->tokens[0].tokenId, condBranchLabel); //Get the relational token name
-  
-  fileOut << "SUB " << tempVarRight << std::endl;
-  fileOut << branchCode << std::endl;
-  
-  genTarget(NODE->child4, table, fileOut); //<stat>
-  
-  fileOut << "BR " << topBranchLabel << std::endl;
-  fileOut << condBranchLabel << ": NOOP" << std::endl;
+  CompilerSession session;
+  return session.compileBuffer(SOURCE, out);
 }
 
 /*
- * Description: The string return are the oppisite of what is given. This is because we are skipping the code below on a bade relation.
- * Passed:      relatOP is the token label relating to that relation operator. label is the label for branching.
- * Returns:     A string with the branches matching the given relation operator.
+ *  Description: This function compiles a given FILENAME and saves it as BUILDNAME.asm if given a string other than "" otherwise a.asm.
+ *               If FILENAME is "" the program is read from stdin. The program is compiled with compileBuffer and the target
+ *               file is only created when the compile succeeds. With OPTIONS.emitIr the three address code is saved
+ *               as BUILDNAME.ir (a.ir) too, with OPTIONS.emitBin the binary object as BUILDNAME.bin (a.bin) and
+ *               without OPTIONS.emitAsm no .asm is saved.
+ *               Throws a invalid_argument error if FILENAME can not be opened.
+ *  Passed:      A string FILENAME to read from. A string BUILDNAME to save as. If BUILDNAME is empty default is a.asm.
+ *               The stream diag to print errors and warnings to and the OPTIONS to compile with.
+ *  Returns:     The status of the parse.
  */
-static std::string getRelationString(const std::string relatOp, const std::string label)
+bool compile(const std::string FILENAME, const std::string BUILDNAME, std::ostream& diag, const CompileOptions OPTIONS)
 {
-  std::string returnString = "";
-  if(relatOp == "LESSEQUAL_tk") // <=
-  {
-     returnString += "BRPOS " + label;
-  }
-  else if(relatOp == "LESSTHAN_tk") // <
-  {
-    returnString += "BRZPOS " + label;
-  }
-  else if(relatOp == "GREATEREQUAL_tk") //>=
+  CompilerSession session(diag, OPTIONS);
+  static thread_local AsmWriter target; //Reused by every compile on the thread, batch compiles share a few threads
+  std::ostringstream ir;
+  std::ostream* irOut = OPTIONS.emitIr ? &ir : nullptr;
+  std::string object;
+  std::string* objectOut = OPTIONS.emitBin ? &object : nullptr;
+  bool success;
+  
+  //Load the input program (source.h)
+  if(FILENAME.empty())
   {
-    returnString += "BRNEG " + label;
+    std::stringstream input;
+    input << std::cin.rdbuf();
+    success = session.compileBuffer(input.str(), target, irOut, objectOut);
   }
-  else if(relatOp == "GREATERTHAN_tk") //>
+  else
   {
-    returnString += "BRZNEG " + label;
+    SourceBuffer source(FILENAME);
+    success = session.compileBuffer(std::string_view(source.begin(), source.end() - source.begin()), target, irOut,
+                                     objectOut);
   }
-  else if(relatOp == "TILDE_tk") // !=
+  if(!success) return false;
+  
+  //Create the target file and write the whole target at once
+  std::string buildName = BUILDNAME.empty() ? "a" : BUILDNAME;
+  if(OPTIONS.emitAsm && !target.writeFile(buildName + ".asm"))
   {
-    returnString += "BRZERO " + label;
+    diag << "Failed to open build file!" << std::endl;
+    return false;
   }
-  else // ==
+  
+  //The binary object goes next to the target as BUILDNAME.bin
+  if(OPTIONS.emitBin && !writeFile(buildName + ".bin", object))
   {
-    returnString += "BRPOS " + label;
-    returnString += "\nBRNEG " + label;
+    diag << "Failed to open object file!" << std::endl;
+    return false;
   }
   
-  return returnString;
-}
-//////////////////////////////////////////////////////////////////////////////////////////////
-
-
-
-//////////////////////////Expression//////////////////////////////////////////////////////////
-/*
- * Description: Handles a full expression of any length. This is a combination of exp and exp2. The result of this expression is left 
- *              in the accumulator(acc) and is expected to be handled by whatever node needs the value.
- * Passed: NODE -> the <expr> node in the tree | table -> the semantic table to add temps to |
- *                 fileOut -> output filestream already opened
- * <exp>  -> <M> <exp2>
- * <exp2> -> + <exp> | - <exp> | empty
- */
-static void handleExp(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut)
-{
-  if(NODE->child2 != nullptr) //<M> (+ <exp> | - <exp>) if <exp2> exists must be one of these two
+  //The three address code goes next to the target as BUILDNAME.ir
+  if(OPTIONS.emitIr)
   {
-    handleExp(NODE->child2->child1, table, fileOut); //the <exp> in <exp2>
-    
-    std::string tempVarEXP = genTempVar(table);
-    fileOut << "STORE " << tempVarEXP << std::endl;
-    
-    M(NODE->child1, table, fileOut); // <M>
-    
-    if(NODE->child2->tokens[0].tokenId == "PLUS_tk")
-    {
-      fileOut << "ADD " << tempVarEXP << std::endl;
-    }
-    else //MINUS_tk
+    std::string irName = buildName + ".ir";
+    std::ofstream irFile(irName.c_str());
+    if(!irFile.is_open())
     {
-      fileOut << "SUB " << tempVarEXP << std::endl;
+      diag << "Failed to open IR file!" << std::endl;
+      return false;
     }
-    return;
-  }
-  else //<M>
-  {
-    M(NODE->child1, table, fileOut);
-    return;
-  }
-}
-
-/*
- * Description: Handles the M and M2 nodes in the tree. This only appears in expression and is expected to be called in handleExp.
- * Passed: NODE -> the <expr> node in the tree | table -> the semantic table to add temps to |
- *                 fileOut -> output filestream already opened
- * <M>  -> <N> <M2>
- * <M2> -> % <M> | empty
- */
-static void M(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut)
-{
-  if(NODE->child2 != nullptr) //<N> % <M> (if there is a child it always goes to % <M> 
-  {
-    M(NODE->child2->child1, table, fileOut); // <M>
-    std::string tempVarM = genTempVar(table);
-    fileOut << "STORE " << tempVarM << std::endl;
-    
-    N(NODE->child1, table, fileOut); // <N>
-    
-    fileOut << "MULT " << tempVarM << std::endl; 
-    
-    return;
-  }
-  else //<N>
-  {
-    N(NODE->child1, table, fileOut); //<N>
-    
-    return;
-  }
-}
-
-/*
- * Description: Handles the N and N2 nodes in the tree. This only appears in expression and is expected to be called in handleExp.
- * Passed: NODE -> the <expr> node in the tree | table -> the semantic table to add temps to |
- *                 fileOut -> output filestream already opened
- * <N>  -> <R> <N2> | - <N>
- * <N2> -> / <N> | empty
- */
-static void N(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut)
-{
-  if(!NODE->tokens.empty() ) // - <N>
-  {
-    N(NODE->child1, table, fileOut);
-    fileOut << "MULT -1" << std:: endl;
-    return;
-  }
-  else if(NODE->child2 != nullptr) //<R> / <N> (if this child <N2> exists it always goes to n)
-  {
-    N(NODE->child2->child1, table, fileOut); //<N>
-    
-    std::string tempVarN = genTempVar(table);
-    fileOut << "STORE " << tempVarN << std::endl;
-    
-    R(NODE->child1, table, fileOut); //<R>
-    
-    fileOut << "DIV " << tempVarN << std::endl;
-    
-    return;
-  }
-  else //MUST GO TO just <R>
-  {
-    R(NODE->child1, table, fileOut);
-    
-    return;
+    irFile << ir.str();
   }
   
+  return true;
 }
 
 /*
- *  Description: Handles a R node in the tree. This only appears in a expression and is expected to be called in handleExp
- * Passed: NODE -> the <expr> node in the tree | table -> the semantic table to add temps to |
- *                 fileOut -> output filestream already opened
- *  <R> -> ( <exp> ) | identifier | integer
- */
-static void R(const std::unique_ptr<Node>& NODE, std::unique_ptr<SemanticTable>& table, std::ofstream& fileOut)
-{
-    if(NODE->child1 != nullptr)
-    {
-      handleExp(NODE->child1, table, fileOut);
-      return;
-    }
-    fileOut << "LOAD " << NODE->tokens[0].instance << std::endl;
-    
-    return;
-}
-//////////////////////////////////////////////////////////////////////////////////////////////
-
-/* Description: Creates a new temp variable name in the form of _(num) in incremental order. The number is then 
- *              added to the semantic table to be printed
- *              at the end of the file.
- * Passed: The semantic table so we can add the new variable to it.
- */
-static std::string genTempVar(std::unique_ptr<SemanticTable>& table)
-{
-  static int tempVarNum = 0;
-  std::string returner = "_" + std::to_string(tempVarNum);
-  table->insert(returner, -1);
-  tempVarNum++;
-  return returner;
-}
-
-/*
- * Description: Creates a new branch lable int he form of B(num) in incremental order.
+ * Description: Renders every instruction of the target into target one per line (asmWriter.h).
+ * Passed: The finished target, the symbol table of its symbols and the writer to render it into.
  */
-static std::string genBranchLabel()
+static void writeTarget(const std::vector<AsmInstr>& CODE, const SymbolTable& SYMBOLS, AsmWriter& target)
 {
-  static int tempLabelNum = 0;
-  std::string returner = "B" + std::to_string(tempLabelNum);
-  tempLabelNum++;
-  return returner;
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+  for(const AsmInstr& instr : CODE) target.instr(instr, SYMBOLS);
+}
\ No newline at end of file
@@ -4,16 +4,84 @@
 #define COMPILER_H
 
 #include <string>
+#include <string_view>
+#include <iostream>
+
+#include "scanner.h"
+#include "parser.h"
+#include "peephole.h"
+#include "asmWriter.h"
+
+//How a program is compiled
+struct CompileOptions {
+  uint32_t peepholeRules = ALL_PEEPHOLE; //Peephole rules to run, bit 1 << rule for each PeepholeRule (peephole.h)
+  bool optReport = false;                //Print what the peephole pass did to diag
+  bool fold = true;                      //Fold expressions (expr.h) and propagate known values (propagate.h)
+  bool emitIr = false;                   //Save the three address code (ir.h) next to the target as name.ir
+  bool emitAsm = true;                   //Save the target as text, name.asm
+  bool emitBin = false;                  //Save the target as a binary object (object.h), name.bin
+  ScannerBackend scanner = DIRECT_scan;  //Which scanner builds the tokens (scanner.h)
+  ParserBackend parser = DESCENT_parse;  //Which parser builds the tree (parser.h), the table one is opt in
+  size_t lexThreads = 1;                 //Threads a big program is scanned on in chunks (lexer.h), 0 is one per core
+  bool pipeline = false;                 //Scan on a thread of its own while the parser reads the tokens (pipeline.h),
+                                         //ignored unless lexThreads is 1
+};
+
+/*
+ * Compiles programs to UMSL's ASM interpreter language. A session only keeps where its messages go and its options,
+ * each compile builds its own tokens, tree and tables. Sessions share nothing so they can compile on different threads.
+ */
+class CompilerSession
+{
+  private:
+    std::ostream& diag;     //Where errors, warnings and failure messages are printed
+    CompileOptions options; //How every program of the session is compiled
+    AsmWriter writer;       //Buffer the targets compiled to a stream are rendered into, reused by every compile
+    
+  public:
+    CompilerSession(std::ostream& diag = std::cout, const CompileOptions OPTIONS = CompileOptions());
+    
+    /*
+     *  Description: Compiles the program in SOURCE and renders the target into target, which is cleared first.
+     *               SOURCE is treated as if it ends with a newline, one is added when it is missing. If there is
+     *               any chracters not in the grammer, bad code structure or a static semantics error a error is
+     *               printed to diag and returns false.
+     *  Passed:      The program SOURCE, the writer to render the target into, the stream irOut to print the
+     *               three address code (ir.h) to and the string objectOut to append the target as a binary
+     *               object (object.h) to. Nothing is printed or appended when they are null.
+     *  Returns:     The status of the compile. target is left empty when it fails.
+     */
+    bool compileBuffer(const std::string_view SOURCE, AsmWriter& target, std::ostream* irOut = nullptr,
+                       std::string* objectOut = nullptr);
+    
+    /*
+     *  Description: Compiles the program in SOURCE like above and writes the finished target to out at once.
+     *  Passed:      The program SOURCE, the stream out to write the target to and the stream irOut to print the
+     *               three address code (ir.h) to, nothing is printed when it is null.
+     *  Returns:     The status of the compile. Nothing is written to out when it fails.
+     */
+    bool compileBuffer(const std::string_view SOURCE, std::ostream& out, std::ostream* irOut = nullptr);
+};
+
+/*
+ *  Description: Compiles SOURCE to out with a new session that prints to cout. See CompilerSession::compileBuffer.
+ *  Passed:      The program SOURCE and the stream out to write the target to.
+ *  Returns:     The status of the compile.
+ */
+bool compileBuffer(const std::string_view SOURCE, std::ostream& out);
 
 /*
- *  Description: This function parses a given FILENAME and saves it as BUILDNAME.asm if given a string other than "" otherwise a.asm.
- *               FILENAME needs to have /n at the end of each line to count lines. FILENAME is then run through parser for a parse tree.
- *               If there is any chracters not in the grammer or bad code structure a error is printed to the screen and returns false.
- *               Static semantics are then run on the parse tree. If static semantics fail a error is printed to the screen return false.
- *               A target is then generated from the confirmed good file. The target is generated in UMSL's ASM interpreter langauge.
+ *  Description: This function compiles a given FILENAME and saves it as BUILDNAME.asm if given a string other than "" otherwise a.asm.
+ *               If FILENAME is "" the program is read from stdin. The program is compiled with compileBuffer and the target
+ *               file is only created when the compile succeeds. With OPTIONS.emitIr the three address code is saved
+ *               as BUILDNAME.ir (a.ir) too, with OPTIONS.emitBin the binary object as BUILDNAME.bin (a.bin) and
+ *               without OPTIONS.emitAsm no .asm is saved.
+ *               Throws a invalid_argument error if FILENAME can not be opened.
  *  Passed:      A string FILENAME to read from. A string BUILDNAME to save as. If BUILDNAME is empty default is a.asm.
+ *               The stream diag to print errors and warnings to and the OPTIONS to compile with.
  *  Returns:     The status of the parse.
  */
-bool compile(const std::string FILENAME, const std::string BUILDNAME);
+bool compile(const std::string FILENAME, const std::string BUILDNAME, std::ostream& diag = std::cout,
+             const CompileOptions OPTIONS = CompileOptions());
 
 #endif
\ No newline at end of file
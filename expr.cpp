@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <climits>
+#include <string>
+
+#include "expr.h"
+
+static ExprId buildM(const Tree& TREE, const NodeId NODE, ExprTree& exprs, const SymbolTable& symbols);
+static ExprId buildN(const Tree& TREE, const NodeId NODE, ExprTree& exprs, const SymbolTable& symbols);
+static ExprId buildR(const Tree& TREE, const NodeId NODE, ExprTree& exprs, const SymbolTable& symbols);
+
+static ExprId makeConst(ExprTree& exprs, const int32_t VALUE);
+static ExprId makeNeg(ExprTree& exprs, const ExprId OPERAND);
+static bool isConst(const ExprTree& EXPRS, const ExprId ID, const int32_t VALUE);
+static bool canFault(const ExprTree& EXPRS, const ExprId ID);
+static int32_t wrap(const int64_t VALUE);
+
+//Adds EXPR to the tree and returns its ID
+ExprId ExprTree::add(const Expr& EXPR)
+{
+  this->nodes.push_back(EXPR);
+  return this->nodes.size() - 1;
+}
+
+/*
+ * Description: Builds the expression of the <exp> node EXP into exprs.
+ * Passed:      The parse tree, the <exp> node, the tree to build into and the symbol table of the tokens
+ * Returns:     The root of the expression
+ * <exp>  -> <M> <exp2>
+ * <exp2> -> + <exp> | - <exp> | empty
+ */
+ExprId buildExpr(const Tree& TREE, const NodeId EXP, ExprTree& exprs, const SymbolTable& symbols)
+{
+  ExprId left = buildM(TREE, TREE[EXP].child1, exprs, symbols);
+  if(TREE[EXP].child2 == NO_NODE) return left;
+  
+  const Node& exp2 = TREE[TREE[EXP].child2];
+  ExprId right = buildExpr(TREE, exp2.child1, exprs, symbols);
+  ExprKind kind = exp2.tokens[0].kind == PLUS_tk ? ADD_ex : SUB_ex;
+  return exprs.add({ kind, 0, 0, left, right });
+}
+
+/*
+ * <M>  -> <N> <M2>
+ * <M2> -> % <M> | empty
+ */
+static ExprId buildM(const Tree& TREE, const NodeId NODE, ExprTree& exprs, const SymbolTable& symbols)
+{
+  ExprId left = buildN(TREE, TREE[NODE].child1, exprs, symbols);
+  if(TREE[NODE].child2 == NO_NODE) return left;
+  
+  ExprId right = buildM(TREE, TREE[TREE[NODE].child2].child1, exprs, symbols);
+  return exprs.add({ MULT_ex, 0, 0, left, right });
+}
+
+/*
+ * <N>  -> <R> <N2> | - <N>
+ * <N2> -> / <N> | empty
+ */
+static ExprId buildN(const Tree& TREE, const NodeId NODE, ExprTree& exprs, const SymbolTable& symbols)
+{
+  if(TREE[NODE].tokenCount != 0) // - <N>
+  {
+    ExprId operand = buildN(TREE, TREE[NODE].child1, exprs, symbols);
+    return exprs.add({ NEG_ex, 0, 0, operand, 0 });
+  }
+  
+  ExprId left = buildR(TREE, TREE[NODE].child1, exprs, symbols);
+  if(TREE[NODE].child2 == NO_NODE) return left;
+  
+  ExprId right = buildN(TREE, TREE[TREE[NODE].child2].child1, exprs, symbols);
+  return exprs.add({ DIV_ex, 0, 0, left, right });
+}
+
+/*
+ * <R> -> ( <exp> ) | identifier | integer
+ */
+static ExprId buildR(const Tree& TREE, const NodeId NODE, ExprTree& exprs, const SymbolTable& symbols)
+{
+  const Node& node = TREE[NODE];
+  if(node.child1 != NO_NODE) return buildExpr(TREE, node.child1, exprs, symbols);
+  
+  const Token& token = node.tokens[0];
+  if(token.kind == ID_tk) return exprs.add({ VAR_ex, 0, token.symbol, 0, 0 });
+  
+  //Integers are unsigned digits, anything past INT_MAX is left for the target machine to read
+  std::string_view digits = symbols.text(token.symbol);
+  int64_t value = 0;
+  for(size_t i = 0; i < digits.size() && value <= INT32_MAX; i++)
+    value = value * 10 + (digits[i] - '0');
+  
+  if(value > INT32_MAX) return exprs.add({ LITERAL_ex, 0, token.symbol, 0, 0 });
+  return makeConst(exprs, value);
+}
+
+/*
+ * Description: Folds the expression at ROOT. Constant subexpressions are evaluated the way the target
+ *              machine would: 32-bit wrap around and division that truncates toward zero. Identities such as
+ *              x + 0, x % 1, x / 1 and - - x are removed. Division that could fault at run time (by zero or
+ *              INT_MIN / -1) is never folded or removed so the program still faults.
+ * Passed:      The expression tree and the root of the expression
+ * Returns:     The root of the folded expression
+ */
+ExprId foldExpr(ExprTree& exprs, const ExprId ROOT)
+{
+  Expr expr = exprs[ROOT];
+  if(expr.kind == CONST_ex || expr.kind == LITERAL_ex || expr.kind == VAR_ex) return ROOT;
+  
+  if(expr.kind == NEG_ex)
+  {
+    ExprId operand = foldExpr(exprs, expr.left);
+    if(operand == expr.left && exprs[operand].kind != CONST_ex && exprs[operand].kind != NEG_ex) return ROOT;
+    
+    return makeNeg(exprs, operand); //Folds - constant and - - x
+  }
+  
+  ExprId left = foldExpr(exprs, expr.left);
+  ExprId right = foldExpr(exprs, expr.right);
+  
+  //Both sides are constant, evaluate it
+  if(exprs[left].kind == CONST_ex && exprs[right].kind == CONST_ex)
+  {
+    int64_t a = exprs[left].value;
+    int64_t b = exprs[right].value;
+    if(expr.kind == ADD_ex) return makeConst(exprs, wrap(a + b));
+    if(expr.kind == SUB_ex) return makeConst(exprs, wrap(a - b));
+    if(expr.kind == MULT_ex) return makeConst(exprs, wrap(a * b));
+    if(b != 0 && !(a == INT32_MIN && b == -1)) return makeConst(exprs, a / b); //DIV_ex that can't fault
+  }
+  
+  if(expr.kind == ADD_ex)
+  {
+    if(isConst(exprs, right, 0)) return left;  // x + 0
+    if(isConst(exprs, left, 0)) return right;  // 0 + x
+    if(exprs[right].kind == NEG_ex) return exprs.add({ SUB_ex, 0, 0, left, exprs[right].left }); // x + - y
+  }
+  else if(expr.kind == SUB_ex)
+  {
+    if(isConst(exprs, right, 0)) return left;               // x - 0
+    if(exprs[right].kind == NEG_ex) return exprs.add({ ADD_ex, 0, 0, left, exprs[right].left }); // x - - y
+    if(isConst(exprs, left, 0)) return makeNeg(exprs, right); // 0 - x
+    if(exprs[left].kind == VAR_ex && exprs[right].kind == VAR_ex && exprs[left].symbol == exprs[right].symbol)
+      return makeConst(exprs, 0);                            // x - x
+  }
+  else if(expr.kind == MULT_ex)
+  {
+    if(isConst(exprs, right, 1)) return left;                 // x % 1
+    if(isConst(exprs, left, 1)) return right;                 // 1 % x
+    if(isConst(exprs, right, -1)) return makeNeg(exprs, left); // x % -1
+    if(isConst(exprs, left, -1)) return makeNeg(exprs, right); // -1 % x
+    if((isConst(exprs, right, 0) && !canFault(exprs, left)) || (isConst(exprs, left, 0) && !canFault(exprs, right)))
+      return makeConst(exprs, 0);                              // x % 0
+  }
+  else //DIV_ex
+  {
+    if(isConst(exprs, right, 1)) return left; // x / 1
+  }
+  
+  if(left == expr.left && right == expr.right) return ROOT;
+  return exprs.add({ expr.kind, 0, 0, left, right });
+}
+
+//Checks if the node ID can be the argument of a instruction as it is, a variable or a 32-bit integer
+bool isOperand(const ExprTree& EXPRS, const ExprId ID)
+{
+  return EXPRS[ID].kind == CONST_ex || EXPRS[ID].kind == VAR_ex;
+}
+
+//Checks if the left side of the + or % at ID should be worked out first and saved in a temp instead of the right
+bool spillLeft(const ExprTree& EXPRS, const ExprId ID)
+{
+  const Expr& expr = EXPRS[ID];
+  return (expr.kind == ADD_ex || expr.kind == MULT_ex) && EXPRS[expr.left].temps > EXPRS[expr.right].temps;
+}
+
+/*
+ * Description: Sethi-Ullman numbering for the single accumulator target. Sets temps of every node under ROOT to
+ *              how many temps it takes to work the node out when it is generated like this:
+ *                left op operand -> <left> op operand
+ *                operand op right -> <right> op operand, for - that is <right> SUB operand MULT -1
+ *                left op right -> the side that needs more temps is worked out first and saved in a temp for
+ *                + and % (spillLeft), the right side for - and /
+ * Passed:      The expression tree and the root of the expression
+ */
+void labelTemps(ExprTree& exprs, const ExprId ROOT)
+{
+  Expr& expr = exprs[ROOT];
+  if(expr.kind == CONST_ex || expr.kind == LITERAL_ex || expr.kind == VAR_ex)
+  {
+    expr.temps = 0;
+    return;
+  }
+  
+  labelTemps(exprs, expr.left);
+  if(expr.kind == NEG_ex)
+  {
+    expr.temps = exprs[expr.left].temps;
+    return;
+  }
+  labelTemps(exprs, expr.right);
+  
+  uint32_t left = exprs[expr.left].temps;
+  uint32_t right = exprs[expr.right].temps;
+  
+  if(isOperand(exprs, expr.right)) expr.temps = left;
+  else if(isOperand(exprs, expr.left) && expr.kind != DIV_ex) expr.temps = right;
+  else if(spillLeft(exprs, ROOT)) expr.temps = std::max(left, right + 1);
+  else expr.temps = std::max(right, left + 1);
+}
+
+//Adds a constant VALUE and returns its ID
+static ExprId makeConst(ExprTree& exprs, const int32_t VALUE)
+{
+  return exprs.add({ CONST_ex, VALUE, 0, 0, 0 });
+}
+
+//Adds - OPERAND and returns its ID, a negated constant is folded and - - x is x
+static ExprId makeNeg(ExprTree& exprs, const ExprId OPERAND)
+{
+  if(exprs[OPERAND].kind == CONST_ex) return makeConst(exprs, wrap(-int64_t(exprs[OPERAND].value)));
+  if(exprs[OPERAND].kind == NEG_ex) return exprs[OPERAND].left;
+  
+  return exprs.add({ NEG_ex, 0, 0, OPERAND, 0 });
+}
+
+//Checks if ID is the constant VALUE
+static bool isConst(const ExprTree& EXPRS, const ExprId ID, const int32_t VALUE)
+{
+  return EXPRS[ID].kind == CONST_ex && EXPRS[ID].value == VALUE;
+}
+
+//Checks if the expression at ID has a division that could fault, by zero or INT_MIN / -1
+static bool canFault(const ExprTree& EXPRS, const ExprId ID)
+{
+  const Expr& expr = EXPRS[ID];
+  if(expr.kind == CONST_ex || expr.kind == LITERAL_ex || expr.kind == VAR_ex) return false;
+  if(expr.kind == NEG_ex) return canFault(EXPRS, expr.left);
+  
+  if(expr.kind == DIV_ex && !(EXPRS[expr.right].kind == CONST_ex && EXPRS[expr.right].value != 0 && EXPRS[expr.right].value != -1))
+    return true;
+  
+  return canFault(EXPRS, expr.left) || canFault(EXPRS, expr.right);
+}
+
+//Wraps VALUE around to 32 bits like the target machine
+static int32_t wrap(const int64_t VALUE)
+{
+  return static_cast<int32_t>(static_cast<uint32_t>(VALUE));
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef EXPR_H
+#define EXPR_H
+
+#include <cstdint>
+#include <vector>
+
+#include "tree.h"
+#include "symbols.h"
+
+//Every type of expression node
+enum ExprKind : uint8_t {
+  CONST_ex,   //Integer that fits in 32 bits
+  LITERAL_ex, //Integer too long for 32 bits, kept as it was written and never folded
+  VAR_ex,     //Variable
+  NEG_ex,     //- left
+  ADD_ex,     //left + right
+  SUB_ex,     //left - right
+  MULT_ex,    //left % right, % is multiplication in the language
+  DIV_ex      //left / right
+};
+
+typedef uint32_t ExprId; //Index of a node in its ExprTree
+
+struct Expr {
+  ExprKind kind;      //What type of node this is
+  int32_t value;      //Value of a CONST_ex
+  uint32_t symbol;    //Symbol ID of a VAR_ex or LITERAL_ex
+  ExprId left;        //Operand of a NEG_ex, left operand of the others
+  ExprId right;       //Right operand
+  uint32_t temps = 0; //How many temps it takes to work out this node, set by labelTemps
+};
+
+/*
+ * An expression as a binary tree of operators. Built from the <exp> subtree of the parse tree so it can be
+ * folded before code generation. The grammar groups from the right so a - b - c is a - (b - c).
+ * Cleared and reused for every expression.
+ */
+class ExprTree
+{
+  private:
+    std::vector<Expr> nodes; //Every node of the expression
+
+  public:
+    //Adds EXPR to the tree and returns its ID
+    ExprId add(const Expr& EXPR);
+
+    Expr& operator[](const ExprId ID) { return this->nodes[ID]; }
+    const Expr& operator[](const ExprId ID) const { return this->nodes[ID]; }
+
+    //Removes every node
+    void clear() { this->nodes.clear(); }
+};
+
+/*
+ * Description: Builds the expression of the <exp> node EXP into exprs.
+ * Passed:      The parse tree, the <exp> node, the tree to build into and the symbol table of the tokens
+ * Returns:     The root of the expression
+ */
+ExprId buildExpr(const Tree& TREE, const NodeId EXP, ExprTree& exprs, const SymbolTable& symbols);
+
+/*
+ * Description: Folds the expression at ROOT. Constant subexpressions are evaluated the way the target
+ *              machine would: 32-bit wrap around and division that truncates toward zero. Identities such as
+ *              x + 0, x % 1, x / 1 and - - x are removed. Division that could fault at run time (by zero or
+ *              INT_MIN / -1) is never folded or removed so the program still faults.
+ * Passed:      The expression tree and the root of the expression
+ * Returns:     The root of the folded expression
+ */
+ExprId foldExpr(ExprTree& exprs, const ExprId ROOT);
+
+//Checks if the node ID can be the argument of a instruction as it is, a variable or a 32-bit integer
+bool isOperand(const ExprTree& EXPRS, const ExprId ID);
+
+//Checks if the left side of the + or % at ID should be worked out first and saved in a temp instead of the right
+bool spillLeft(const ExprTree& EXPRS, const ExprId ID);
+
+/*
+ * Description: Sethi-Ullman numbering for the single accumulator target. Sets temps of every node under ROOT to
+ *              how many temps it takes to work the node out when it is generated like this:
+ *                left op operand -> <left> op operand
+ *                operand op right -> <right> op operand, for - that is <right> SUB operand MULT -1
+ *                left op right -> the side that needs more temps is worked out first and saved in a temp for
+ *                + and % (spillLeft), the right side for - and /
+ * Passed:      The expression tree and the root of the expression
+ */
+void labelTemps(ExprTree& exprs, const ExprId ROOT);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,322 @@
+#ifndef GRAMMAR_H
+#define GRAMMAR_H
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+
+#include "language.h"
+#include "tree.h"
+
+/*
+ * The BNF in parser.h as data for the table driven parser. FIRST and FOLLOW of every nonterminal and the LL(1) parse
+ * table are worked out from it at compile time, a grammar that is not LL(1) does not compile. Besides the symbols each
+ * production says which node it builds and how its symbols go into the tree, the way the recursive descent parser
+ * builds them, and each symbol what a error says is expected there.
+ */
+
+//Every nonterminal of the BNF
+enum Nonterminal : uint8_t {
+  PROGRAM_nt, VARS_nt, VARLIST_nt, VARLIST2_nt, STATS_nt, MSTAT_nt, STAT_nt, BLOCK_nt, READ_nt, PRINT_nt, COND_nt,
+  ITER_nt, ASSIGN_nt, RELATIONAL_nt, EXP_nt, EXP2_nt, M_nt, M2_nt, N_nt, N2_nt, R_nt,
+  NONTERMINALS //How many nonterminals there are
+};
+
+//Every token the parser looks ahead at has a column of the parse table, keywords have one each after the token kinds
+const int LOOKAHEADS = TOKENKINDS + KEYWORDSIZE;
+const uint8_t ANY_KEYWORD = LOOKAHEADS; //Terminal that is any keyword
+static_assert(LOOKAHEADS <= 64, "A set of lookaheads has to fit in 64 bits");
+
+//Set of every keyword lookahead
+constexpr uint64_t KEYWORD_LOOKAHEADS = ((uint64_t(1) << KEYWORDSIZE) - 1) << TOKENKINDS;
+constexpr uint64_t ALL_LOOKAHEADS = KEYWORD_LOOKAHEADS | ((uint64_t(1) << TOKENKINDS) - 1);
+
+//Column of the parse table for TOKEN
+inline int lookahead(const Token& TOKEN)
+{
+  return TOKEN.kind == KEYWORD_tk ? TOKENKINDS + TOKEN.keyword : TOKEN.kind;
+}
+
+//How a symbol of a production goes into the tree
+enum SymbolLink : uint8_t {
+  DROP_ln,  //Terminal that is only checked
+  KEEP_ln,  //Terminal added to the tokens of the node of the production
+  CHILD_ln, //Nonterminal whose node is the next child of the node of the production, or of a production without a
+            //node is put where the node of the production would have been
+  NEXT_ln,  //Nonterminal whose node is the next of the node of the production
+  AFTER_ln  //Nonterminal whose node is the next of the node the nonterminal before it built
+};
+
+const uint8_t NEXT_SLOT = 4;     //Slot of a node that is its next, the slots before it are child1 to child4
+const uint8_t INHERIT_SLOT = 5;  //A nonterminal of a production without a node takes the slot of the production
+
+//A terminal or nonterminal of the body of a production
+struct GrammarSymbol {
+  bool terminal;
+  uint8_t id;           //Lookahead column of a terminal or ANY_KEYWORD, Nonterminal of a nonterminal
+  SymbolLink link;
+  const char* expected; //What the error says is expected when a terminal does not match
+  uint8_t slot;         //Where the node of a nonterminal goes in the node of the production, set by rule
+  bool handsOver;       //Nonterminal followed by a AFTER_ln one, set by rule
+};
+
+const int MAXBODY = 8; //Most symbols a production has
+
+//A production, head -> body. node is NODEKINDS for one that builds no node
+struct Production {
+  Nonterminal head;
+  NodeKind node;
+  uint8_t length;
+  GrammarSymbol body[MAXBODY];
+};
+
+//Terminal token KIND, KEYWORD_tk is any keyword
+constexpr GrammarSymbol tk(const TokenKind KIND, const char* EXPECTED, const SymbolLink LINK = DROP_ln)
+{
+  return { true, KIND == KEYWORD_tk ? ANY_KEYWORD : static_cast<uint8_t>(KIND), LINK, EXPECTED, 0, false };
+}
+
+//Terminal keyword KEYWORD
+constexpr GrammarSymbol kw(const Keyword KEYWORD, const char* EXPECTED)
+{
+  return { true, static_cast<uint8_t>(TOKENKINDS + KEYWORD), DROP_ln, EXPECTED, 0, false };
+}
+
+//Nonterminal NONTERMINAL
+constexpr GrammarSymbol nt(const Nonterminal NONTERMINAL, const SymbolLink LINK = CHILD_ln)
+{
+  return { false, NONTERMINAL, LINK, "", 0, false };
+}
+
+//Production HEAD -> BODY building a NODE. The nonterminals of the body are numbered as children first to last
+constexpr Production rule(const Nonterminal HEAD, const NodeKind NODE, std::initializer_list<GrammarSymbol> BODY)
+{
+  Production production = { HEAD, NODE, 0, {} };
+  uint8_t children = 0;
+  for(GrammarSymbol symbol : BODY)
+  {
+    if(symbol.link == CHILD_ln) symbol.slot = NODE == NODEKINDS ? INHERIT_SLOT : children++;
+    if(symbol.link == NEXT_ln || symbol.link == AFTER_ln) symbol.slot = NEXT_SLOT;
+    if(symbol.link == AFTER_ln) production.body[production.length - 1].handsOver = true;
+    production.body[production.length++] = symbol;
+  }
+  return production;
+}
+
+constexpr const char* OPERAND = "(, identifer, or integer"; //What is expected where a operand of a expression starts
+
+/*
+ * The BNF. The program keyword is any keyword and every list links its items through Node::next as the recursive
+ * descent parser has them.
+ */
+constexpr Production GRAMMAR[] = {
+  rule(PROGRAM_nt, PROGRAM_nd, { tk(KEYWORD_tk, "program"), nt(VARS_nt), nt(BLOCK_nt), tk(EOF_tk, "EOF") }),
+  rule(VARS_nt, VARS_nd, { kw(VAR_kw, "var"), nt(VARLIST_nt) }),
+  rule(VARS_nt, VARS_nd, {}),
+  rule(VARLIST_nt, VARLIST_nd, { tk(ID_tk, "identifier", KEEP_ln), tk(COMMA_tk, ","), tk(INT_tk, "integer", KEEP_ln),
+                                 nt(VARLIST2_nt, NEXT_ln) }),
+  rule(VARLIST2_nt, NODEKINDS, { tk(SEMICOLON_tk, ";") }),
+  rule(VARLIST2_nt, NODEKINDS, { nt(VARLIST_nt) }),
+  rule(STATS_nt, STATS_nd, { nt(STAT_nt), nt(MSTAT_nt, AFTER_ln) }),
+  rule(MSTAT_nt, NODEKINDS, { nt(STAT_nt), nt(MSTAT_nt, AFTER_ln) }),
+  rule(MSTAT_nt, NODEKINDS, {}),
+  rule(STAT_nt, STAT_nd, { nt(READ_nt) }),
+  rule(STAT_nt, STAT_nd, { nt(PRINT_nt) }),
+  rule(STAT_nt, STAT_nd, { nt(BLOCK_nt) }),
+  rule(STAT_nt, STAT_nd, { nt(COND_nt) }),
+  rule(STAT_nt, STAT_nd, { nt(ITER_nt) }),
+  rule(STAT_nt, STAT_nd, { nt(ASSIGN_nt) }),
+  rule(BLOCK_nt, BLOCK_nd, { kw(START_kw, "start"), nt(VARS_nt), nt(STATS_nt), kw(STOP_kw, "stop") }),
+  rule(READ_nt, READ_nd, { kw(READ_kw, "read"), tk(ID_tk, "Identifier", KEEP_ln), tk(SEMICOLON_tk, ";") }),
+  rule(PRINT_nt, PRINT_nd, { kw(PRINT_kw, "print"), nt(EXP_nt), tk(SEMICOLON_tk, ";") }),
+  rule(COND_nt, COND_nd, { kw(IFF_kw, "iff"), tk(LEFTBRACKET_tk, "[", KEEP_ln), nt(EXP_nt), nt(RELATIONAL_nt),
+                           nt(EXP_nt), tk(RIGHTBRACKET_tk, "]", KEEP_ln), nt(STAT_nt) }),
+  rule(ITER_nt, ITER_nd, { kw(ITERATE_kw, "iterate"), tk(LEFTBRACKET_tk, "[", KEEP_ln), nt(EXP_nt), nt(RELATIONAL_nt),
+                           nt(EXP_nt), tk(RIGHTBRACKET_tk, "]", KEEP_ln), nt(STAT_nt) }),
+  rule(ASSIGN_nt, ASSIGN_nd, { kw(SET_kw, "set"), tk(ID_tk, "identifier", KEEP_ln), nt(EXP_nt),
+                               tk(SEMICOLON_tk, ";") }),
+  rule(RELATIONAL_nt, RELATIONAL_nd, { tk(LESSEQUAL_tk, "relational operator", KEEP_ln) }),
+  rule(RELATIONAL_nt, RELATIONAL_nd, { tk(GREATEREQUAL_tk, "relational operator", KEEP_ln) }),
+  rule(RELATIONAL_nt, RELATIONAL_nd, { tk(LESSTHAN_tk, "relational operator", KEEP_ln) }),
+  rule(RELATIONAL_nt, RELATIONAL_nd, { tk(GREATERTHAN_tk, "relational operator", KEEP_ln) }),
+  rule(RELATIONAL_nt, RELATIONAL_nd, { tk(ASTERISK_tk, "relational operator", KEEP_ln) }),
+  rule(RELATIONAL_nt, RELATIONAL_nd, { tk(TILDE_tk, "relational operator", KEEP_ln) }),
+  rule(EXP_nt, EXP_nd, { nt(M_nt), nt(EXP2_nt) }),
+  rule(EXP2_nt, EXP2_nd, { tk(PLUS_tk, "+", KEEP_ln), nt(EXP_nt) }),
+  rule(EXP2_nt, EXP2_nd, { tk(MINUS_tk, "-", KEEP_ln), nt(EXP_nt) }),
+  rule(EXP2_nt, NODEKINDS, {}),
+  rule(M_nt, M_nd, { nt(N_nt), nt(M2_nt) }),
+  rule(M2_nt, M2_nd, { tk(PERCENT_tk, "%", KEEP_ln), nt(M_nt) }),
+  rule(M2_nt, NODEKINDS, {}),
+  rule(N_nt, N_nd, { nt(R_nt), nt(N2_nt) }),
+  rule(N_nt, N_nd, { tk(MINUS_tk, "-", KEEP_ln), nt(N_nt) }),
+  rule(N2_nt, N2_nd, { tk(FORWARDSLASH_tk, "/", KEEP_ln), nt(N_nt) }),
+  rule(N2_nt, NODEKINDS, {}),
+  rule(R_nt, R_nd, { tk(LEFTPAREN_tk, "(", KEEP_ln), nt(EXP_nt), tk(RIGHTPAREN_tk, ")", KEEP_ln) }),
+  rule(R_nt, R_nd, { tk(ID_tk, "identifier", KEEP_ln) }),
+  rule(R_nt, R_nd, { tk(INT_tk, "integer", KEEP_ln) })
+};
+
+const int PRODUCTIONS = sizeof(GRAMMAR) / sizeof(GRAMMAR[0]);
+
+//How a nonterminal is parsed when no production of it starts with the lookahead
+struct NonterminalError {
+  const char* expected; //What the error says is expected
+  uint64_t emptyOn;     //Lookaheads its empty production is taken on instead, the error is found by what follows
+};
+
+//Every nonterminal by Nonterminal. A empty production is taken on more than FOLLOW so the errors are the ones the
+//recursive descent parser gives, each one is checked by a program in errors/parse:
+// - VARS_nt on anything, <vars> is empty unless it starts with var so "program x" expects start (novars)
+// - MSTAT_nt on every keyword, <mStat> is empty on a keyword that starts no statement so "var" in a block expects
+//   stop (statkeyword). On a identifier it stays a error of its own, "Statement Keyword" (statid)
+// - EXP2_nt, M2_nt and N2_nt on anything, the functions for them return without a operator so what follows the
+//   operand is the error, "set x 1 2" expects ; (exp2, m2, n2)
+constexpr NonterminalError NONTERMINAL_ERRORS[NONTERMINALS] = {
+  { "program", 0 },                            //PROGRAM_nt
+  { "var", ALL_LOOKAHEADS },                   //VARS_nt
+  { "identifier", 0 },                         //VARLIST_nt
+  { "identifier", 0 },                         //VARLIST2_nt
+  { "Statement Keyword", 0 },                  //STATS_nt
+  { "Statement Keyword", KEYWORD_LOOKAHEADS }, //MSTAT_nt
+  { "Statement Keyword", 0 },                  //STAT_nt
+  { "start", 0 },                              //BLOCK_nt
+  { "read", 0 },                               //READ_nt
+  { "print", 0 },                              //PRINT_nt
+  { "iff", 0 },                                //COND_nt
+  { "iterate", 0 },                            //ITER_nt
+  { "set", 0 },                                //ASSIGN_nt
+  { "relational operator", 0 },                //RELATIONAL_nt
+  { OPERAND, 0 },                              //EXP_nt
+  { "+ or -", ALL_LOOKAHEADS },                //EXP2_nt
+  { OPERAND, 0 },                              //M_nt
+  { "%", ALL_LOOKAHEADS },                     //M2_nt
+  { OPERAND, 0 },                              //N_nt
+  { "/", ALL_LOOKAHEADS },                     //N2_nt
+  { OPERAND, 0 }                               //R_nt
+};
+
+//FIRST and FOLLOW of every nonterminal as sets of lookaheads and if it derives empty
+struct GrammarSets {
+  uint64_t first[NONTERMINALS] = {};
+  uint64_t follow[NONTERMINALS] = {};
+  bool nullable[NONTERMINALS] = {};
+};
+
+//Lookaheads the terminal SYMBOL matches
+constexpr uint64_t terminalSet(const GrammarSymbol& SYMBOL)
+{
+  return SYMBOL.id == ANY_KEYWORD ? KEYWORD_LOOKAHEADS : uint64_t(1) << SYMBOL.id;
+}
+
+/*
+ * Works out FIRST of the symbols of PRODUCTION from symbol BEGIN on with what SETS knows so far.
+ * Sets nullable if they all derive empty.
+ */
+constexpr uint64_t bodyFirst(const Production& PRODUCTION, const int BEGIN, const GrammarSets& SETS, bool& nullable)
+{
+  uint64_t first = 0;
+  nullable = true;
+  for(int i = BEGIN; i < PRODUCTION.length && nullable; i++)
+  {
+    const GrammarSymbol& symbol = PRODUCTION.body[i];
+    first |= symbol.terminal ? terminalSet(symbol) : SETS.first[symbol.id];
+    nullable = !symbol.terminal && SETS.nullable[symbol.id];
+  }
+  return first;
+}
+
+//Works out FIRST, FOLLOW and which nonterminals derive empty by going over GRAMMAR until nothing is added
+constexpr GrammarSets buildGrammarSets()
+{
+  GrammarSets sets;
+  for(bool changed = true; changed; )
+  {
+    changed = false;
+    for(const Production& production : GRAMMAR)
+    {
+      bool nullable = false;
+      uint64_t first = sets.first[production.head] | bodyFirst(production, 0, sets, nullable);
+      nullable = nullable || sets.nullable[production.head];
+      changed = changed || first != sets.first[production.head] || nullable != sets.nullable[production.head];
+      sets.first[production.head] = first;
+      sets.nullable[production.head] = nullable;
+    }
+  }
+  
+  //Every nonterminal is followed by FIRST of what comes after it and by FOLLOW of the head when that derives empty
+  for(bool changed = true; changed; )
+  {
+    changed = false;
+    for(const Production& production : GRAMMAR)
+      for(int i = 0; i < production.length; i++)
+      {
+        if(production.body[i].terminal) continue;
+        
+        bool nullable = false;
+        uint64_t follow = sets.follow[production.body[i].id] | bodyFirst(production, i + 1, sets, nullable);
+        if(nullable) follow |= sets.follow[production.head];
+        changed = changed || follow != sets.follow[production.body[i].id];
+        sets.follow[production.body[i].id] = follow;
+      }
+  }
+  
+  return sets;
+}
+
+constexpr GrammarSets GRAMMAR_SETS = buildGrammarSets();
+
+const uint8_t NO_PRODUCTION = 0xFF; //Cell of the parse table for a lookahead no production starts with
+const uint8_t CONFLICT = 0xFE;      //Cell two productions start with, the grammar is not LL(1)
+
+typedef std::array<std::array<uint8_t, LOOKAHEADS>, NONTERMINALS> ParseTable;
+
+/*
+ * Builds the LL(1) parse table, the production of each nonterminal to take for each lookahead. A production is taken
+ * on FIRST of its body and on FOLLOW of its head when the body derives empty, a empty production also on the
+ * lookaheads in NONTERMINAL_ERRORS no other production is taken on.
+ */
+constexpr ParseTable buildParseTable()
+{
+  ParseTable table = {};
+  for(std::array<uint8_t, LOOKAHEADS>& row : table)
+    for(uint8_t& cell : row) cell = NO_PRODUCTION;
+  
+  for(int p = 0; p < PRODUCTIONS; p++)
+  {
+    bool nullable = false;
+    uint64_t predict = bodyFirst(GRAMMAR[p], 0, GRAMMAR_SETS, nullable);
+    if(nullable) predict |= GRAMMAR_SETS.follow[GRAMMAR[p].head];
+    for(int column = 0; column < LOOKAHEADS; column++)
+      if(predict >> column & 1)
+      {
+        uint8_t& cell = table[GRAMMAR[p].head][column];
+        cell = cell == NO_PRODUCTION ? p : CONFLICT;
+      }
+  }
+  
+  for(int p = 0; p < PRODUCTIONS; p++)
+    if(GRAMMAR[p].length == 0)
+      for(int column = 0; column < LOOKAHEADS; column++)
+      {
+        uint8_t& cell = table[GRAMMAR[p].head][column];
+        if(cell == NO_PRODUCTION && (NONTERMINAL_ERRORS[GRAMMAR[p].head].emptyOn >> column & 1)) cell = p;
+      }
+  
+  return table;
+}
+
+//Checks no cell of TABLE is a conflict
+constexpr bool isLL1(const ParseTable& TABLE)
+{
+  for(const std::array<uint8_t, LOOKAHEADS>& row : TABLE)
+    for(uint8_t cell : row)
+      if(cell == CONFLICT) return false;
+  return true;
+}
+
+//The production to take for every nonterminal and lookahead, built at compile time
+constexpr ParseTable PARSE_TABLE = buildParseTable();
+static_assert(isLL1(PARSE_TABLE), "The grammar is not LL(1)");
+
+#endif
\ No newline at end of file
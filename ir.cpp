@@ -0,0 +1,229 @@
+#include <cctype>
+
+#include "ir.h"
+
+const char* const IROP_NAMES[IROPS] = { "copy", "neg", "add", "sub", "mult", "div", "read", "write" };
+
+const char* const RELATION_NAMES[RELATIONS] = { ".le.", ".lt.", ".ge.", ".gt.", "**", "~" };
+
+static void printArg(const IrArg& ARG, const SymbolTable& SYMBOLS, std::ostream& out);
+static std::string checkValue(const IrArg& ARG, const uint32_t BLOCK, const std::vector<uint32_t>& SETIN,
+                              const IrProgram& PROGRAM, const SymbolTable& SYMBOLS);
+static bool isLiteral(const IrArg& ARG, const SymbolTable& SYMBOLS);
+
+//Returns how many instructions are in PROGRAM counting every terminator as one
+size_t irSize(const IrProgram& PROGRAM)
+{
+  size_t size = 0;
+  for(const IrBlock& block : PROGRAM.blocks) size += block.instrs.size() + 1;
+  return size;
+}
+
+//Checks if INSTR is a division that could fault, by zero or the smallest integer by -1
+bool canFault(const IrInstr& INSTR)
+{
+  if(INSTR.op != DIV_ir) return false;
+  
+  return INSTR.b.kind != INT_ia || INSTR.b.id == 0 || INSTR.b.id == static_cast<uint32_t>(-1);
+}
+
+//Checks if RELATION holds for the left side minus the right side being DIFFERENCE
+bool testHolds(const Relation RELATION, const int32_t DIFFERENCE)
+{
+  if(RELATION == LE_rel) return DIFFERENCE <= 0;
+  if(RELATION == LT_rel) return DIFFERENCE < 0;
+  if(RELATION == GE_rel) return DIFFERENCE >= 0;
+  if(RELATION == GT_rel) return DIFFERENCE > 0;
+  if(RELATION == EQ_rel) return DIFFERENCE == 0;
+  return DIFFERENCE != 0;
+}
+
+/*
+ * Description: Prints PROGRAM one instruction per line with every block under its B(num): label.
+ *              Temps are printed as %(num).
+ * Passed:      The program, the symbol table its symbols are interned in and the stream to print to.
+ */
+void printIr(const IrProgram& PROGRAM, const SymbolTable& SYMBOLS, std::ostream& out)
+{
+  for(size_t i = 0; i < PROGRAM.blocks.size(); i++)
+  {
+    const IrBlock& block = PROGRAM.blocks[i];
+    out << "B" << i << ":" << std::endl;
+    
+    for(const IrInstr& instr : block.instrs)
+    {
+      out << "  ";
+      if(instr.op == READ_ir) //read dest
+      {
+        out << IROP_NAMES[instr.op] << " ";
+        printArg(instr.dest, SYMBOLS, out);
+      }
+      else if(instr.op == WRITE_ir) //write a
+      {
+        out << IROP_NAMES[instr.op] << " ";
+        printArg(instr.a, SYMBOLS, out);
+      }
+      else //dest = op a, b
+      {
+        printArg(instr.dest, SYMBOLS, out);
+        out << " = " << IROP_NAMES[instr.op] << " ";
+        printArg(instr.a, SYMBOLS, out);
+        if(instr.b.kind != NONE_ia)
+        {
+          out << ", ";
+          printArg(instr.b, SYMBOLS, out);
+        }
+      }
+      out << std::endl;
+    }
+    
+    if(block.term == JUMP_tm)
+    {
+      out << "  goto B" << block.target << std::endl;
+    }
+    else if(block.term == CBR_tm)
+    {
+      out << "  if ";
+      printArg(block.a, SYMBOLS, out);
+      out << " " << RELATION_NAMES[block.rel] << " ";
+      printArg(block.b, SYMBOLS, out);
+      out << " goto B" << block.target << " else B" << block.other << std::endl;
+    }
+    else
+    {
+      out << "  stop" << std::endl;
+    }
+  }
+}
+
+/*
+ * Description: Checks that PROGRAM is well formed: every instruction has the arguments its op takes, every
+ *              branch goes to a block that exists, every temp is set once and only used after that in the
+ *              same block and integers too big for 32 bits are only copied.
+ * Passed:      The program and the symbol table its symbols are interned in.
+ * Returns:     What is wrong with the first bad instruction found or "" if the program is well formed.
+ */
+std::string verifyIr(const IrProgram& PROGRAM, const SymbolTable& SYMBOLS)
+{
+  if(PROGRAM.blocks.empty()) return "program has no blocks";
+  
+  //The block each temp was set in, blocks.size() while it has not been set
+  std::vector<uint32_t> setIn(PROGRAM.temps, PROGRAM.blocks.size());
+  
+  for(uint32_t i = 0; i < PROGRAM.blocks.size(); i++)
+  {
+    const IrBlock& block = PROGRAM.blocks[i];
+    std::string where = "B" + std::to_string(i);
+    
+    for(size_t j = 0; j < block.instrs.size(); j++)
+    {
+      const IrInstr& instr = block.instrs[j];
+      std::string at = where + " instruction " + std::to_string(j) + ": ";
+      std::string error;
+      
+      if(instr.op >= IROPS) return at + "unknown op";
+      
+      //Operands
+      if(instr.op == READ_ir)
+      {
+        if(instr.a.kind != NONE_ia || instr.b.kind != NONE_ia) return at + "read takes no operands";
+      }
+      else
+      {
+        error = checkValue(instr.a, i, setIn, PROGRAM, SYMBOLS);
+        if(!error.empty()) return at + error;
+        if(isLiteral(instr.a, SYMBOLS) && instr.op != COPY_ir) return at + "only copy can use a integer too big for 32 bits";
+        
+        bool binary = instr.op == ADD_ir || instr.op == SUB_ir || instr.op == MULT_ir || instr.op == DIV_ir;
+        if(binary)
+        {
+          error = checkValue(instr.b, i, setIn, PROGRAM, SYMBOLS);
+          if(!error.empty()) return at + error;
+          if(isLiteral(instr.b, SYMBOLS)) return at + "only copy can use a integer too big for 32 bits";
+        }
+        else if(instr.b.kind != NONE_ia)
+        {
+          return at + IROP_NAMES[instr.op] + " takes one operand";
+        }
+      }
+      
+      //Destination
+      if(instr.op == WRITE_ir)
+      {
+        if(instr.dest.kind != NONE_ia) return at + "write has no destination";
+      }
+      else if(instr.dest.kind == SYMBOL_ia)
+      {
+        if(instr.dest.id >= SYMBOLS.size() || isLiteral(instr.dest, SYMBOLS)) return at + "destination is not a variable";
+      }
+      else if(instr.dest.kind == TEMP_ia && instr.op != READ_ir)
+      {
+        if(instr.dest.id >= PROGRAM.temps) return at + "temp %" + std::to_string(instr.dest.id) + " was never made";
+        if(setIn[instr.dest.id] != PROGRAM.blocks.size()) return at + "temp %" + std::to_string(instr.dest.id) + " is set twice";
+        setIn[instr.dest.id] = i;
+      }
+      else
+      {
+        return at + "destination is not a variable or temp";
+      }
+    }
+    
+    //Terminator
+    std::string at = where + " terminator: ";
+    if(block.term == JUMP_tm)
+    {
+      if(block.target >= PROGRAM.blocks.size()) return at + "goes to a block that does not exist";
+    }
+    else if(block.term == CBR_tm)
+    {
+      if(block.rel >= RELATIONS) return at + "unknown relation";
+      if(block.target >= PROGRAM.blocks.size() || block.other >= PROGRAM.blocks.size()) return at + "goes to a block that does not exist";
+      
+      std::string error = checkValue(block.a, i, setIn, PROGRAM, SYMBOLS);
+      if(error.empty()) error = checkValue(block.b, i, setIn, PROGRAM, SYMBOLS);
+      if(!error.empty()) return at + error;
+      if(isLiteral(block.a, SYMBOLS) || isLiteral(block.b, SYMBOLS)) return at + "only copy can use a integer too big for 32 bits";
+    }
+    else if(block.term != STOP_tm)
+    {
+      return at + "unknown terminator";
+    }
+  }
+  
+  return "";
+}
+
+//Prints ARG as a variable name, %(temp) or integer
+static void printArg(const IrArg& ARG, const SymbolTable& SYMBOLS, std::ostream& out)
+{
+  if(ARG.kind == SYMBOL_ia) out << SYMBOLS.text(ARG.id);
+  else if(ARG.kind == TEMP_ia) out << "%" << ARG.id;
+  else if(ARG.kind == INT_ia) out << static_cast<int32_t>(ARG.id);
+}
+
+/*
+ * Description: Checks that ARG can be read in BLOCK. A symbol must exist and a temp must have been set
+ *              earlier in BLOCK.
+ * Passed:      The argument, the block it is read in, the block every temp was set in, the program and its symbols.
+ * Returns:     What is wrong with ARG or "".
+ */
+static std::string checkValue(const IrArg& ARG, const uint32_t BLOCK, const std::vector<uint32_t>& SETIN,
+                              const IrProgram& PROGRAM, const SymbolTable& SYMBOLS)
+{
+  if(ARG.kind == INT_ia) return "";
+  if(ARG.kind == SYMBOL_ia) return ARG.id < SYMBOLS.size() ? "" : "unknown symbol";
+  if(ARG.kind != TEMP_ia) return "missing operand";
+  
+  std::string temp = "temp %" + std::to_string(ARG.id);
+  if(ARG.id >= PROGRAM.temps) return temp + " was never made";
+  if(SETIN[ARG.id] == PROGRAM.blocks.size()) return temp + " is used before it is set";
+  if(SETIN[ARG.id] != BLOCK) return temp + " is used outside the block that sets it";
+  
+  return "";
+}
+
+//Checks if ARG is a integer too big for 32 bits, they are the only symbols that start with a digit
+static bool isLiteral(const IrArg& ARG, const SymbolTable& SYMBOLS)
+{
+  return ARG.kind == SYMBOL_ia && ARG.id < SYMBOLS.size() && isdigit(static_cast<unsigned char>(SYMBOLS.text(ARG.id)[0]));
+}
\ No newline at end of file
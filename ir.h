@@ -0,0 +1,123 @@
+#ifndef IR_H
+#define IR_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "symbols.h"
+
+/*
+ * Three address intermediate representation between the parse tree and the target. A program is a list of
+ * basic blocks in the order they are laid out, block 0 runs first. Every block is a list of instructions
+ * followed by one terminator that says where control goes next.
+ *
+ * Variables live in memory. Temps hold the value of a subexpression, each temp is set by exactly one
+ * instruction and only used after it in the same block, so they never live across a branch.
+ */
+
+//Every instruction that is not a terminator
+enum IrOp : uint8_t {
+  COPY_ir,  //dest = a
+  NEG_ir,   //dest = - a
+  ADD_ir,   //dest = a + b
+  SUB_ir,   //dest = a - b
+  MULT_ir,  //dest = a * b, % in the language
+  DIV_ir,   //dest = a / b
+  READ_ir,  //read dest
+  WRITE_ir, //write a
+  IROPS     //How many instructions there are
+};
+
+//What a IrArg refers to
+enum IrArgKind : uint8_t {
+  NONE_ia,   //Nothing
+  SYMBOL_ia, //A variable, or a integer too big for 32 bits which is only ever copied, by symbol ID
+  TEMP_ia,   //A temp by number
+  INT_ia     //A 32-bit integer stored as its 32 bits
+};
+
+//How a block ends
+enum IrTerm : uint8_t {
+  JUMP_tm, //Go to target
+  CBR_tm,  //Go to target if a rel b holds, otherwise to other
+  STOP_tm  //End the program
+};
+
+//The relations a CBR_tm can test. Like the target it tests a - b against 0 with 32-bit wrap around
+enum Relation : uint8_t {
+  LE_rel, LT_rel, GE_rel, GT_rel, EQ_rel, NE_rel,
+  RELATIONS //How many relations there are
+};
+
+//The name of every IrOp and Relation as they are printed by printIr
+extern const char* const IROP_NAMES[IROPS];
+extern const char* const RELATION_NAMES[RELATIONS];
+
+//A operand or destination of a instruction
+struct IrArg {
+  IrArgKind kind;
+  uint32_t id; //Symbol ID, temp number or integer
+};
+
+//A instruction. Arguments the instruction does not have are NONE_ia
+struct IrInstr {
+  IrOp op;
+  IrArg dest;
+  IrArg a;
+  IrArg b;
+  int line; //Source line of the statement it was made for, 0 if there is none
+};
+
+struct IrBlock {
+  std::vector<IrInstr> instrs; //Everything the block does before its terminator
+  IrTerm term;                 //How the block ends
+  Relation rel;                //Relation tested by a CBR_tm
+  IrArg a;                     //Left side of the relation
+  IrArg b;                     //Right side of the relation
+  uint32_t target;             //Block of a JUMP_tm, block a CBR_tm goes to when the relation holds
+  uint32_t other;              //Block a CBR_tm goes to when the relation does not hold
+  int line;                    //Source line of the relation a CBR_tm tests, 0 for other terminators
+};
+
+struct IrProgram {
+  std::vector<IrBlock> blocks; //Every block in the order they are laid out
+  uint32_t temps;              //How many temps have been made, temps are numbered from 0
+};
+
+//Makes IrArg values
+inline IrArg noArg() { return { NONE_ia, 0 }; }
+inline IrArg symbolArg(const uint32_t SYMBOL) { return { SYMBOL_ia, SYMBOL }; }
+inline IrArg tempArg(const uint32_t TEMP) { return { TEMP_ia, TEMP }; }
+inline IrArg intArg(const int32_t VALUE) { return { INT_ia, static_cast<uint32_t>(VALUE) }; }
+
+inline bool operator==(const IrArg& A, const IrArg& B) { return A.kind == B.kind && A.id == B.id; }
+inline bool operator!=(const IrArg& A, const IrArg& B) { return !(A == B); }
+
+//Returns how many instructions are in PROGRAM counting every terminator as one
+size_t irSize(const IrProgram& PROGRAM);
+
+//Checks if INSTR is a division that could fault, by zero or the smallest integer by -1
+bool canFault(const IrInstr& INSTR);
+
+//Checks if RELATION holds for the left side minus the right side being DIFFERENCE
+bool testHolds(const Relation RELATION, const int32_t DIFFERENCE);
+
+/*
+ * Description: Prints PROGRAM one instruction per line with every block under its B(num): label.
+ *              Temps are printed as %(num).
+ * Passed:      The program, the symbol table its symbols are interned in and the stream to print to.
+ */
+void printIr(const IrProgram& PROGRAM, const SymbolTable& SYMBOLS, std::ostream& out);
+
+/*
+ * Description: Checks that PROGRAM is well formed: every instruction has the arguments its op takes, every
+ *              branch goes to a block that exists, every temp is set once and only used after that in the
+ *              same block and integers too big for 32 bits are only copied.
+ * Passed:      The program and the symbol table its symbols are interned in.
+ * Returns:     What is wrong with the first bad instruction found or "" if the program is well formed.
+ */
+std::string verifyIr(const IrProgram& PROGRAM, const SymbolTable& SYMBOLS);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include <iostream>
+
+#include "irGen.h"
+#include "expr.h"
+
+/*
+ * Object for the IR being generated to be passed throughout lowering.
+ */
+struct IrGenObj {
+  const Tree &tree;     //Parse tree the IR is generated from
+  SymbolTable &symbols; //Where the tokens of the tree are interned
+  bool fold;            //If every expression is folded before it is generated
+  IrProgram program;    //The program being built
+  uint32_t current;     //Block instructions are being added to
+  ExprTree exprs = {};  //The expression being generated, reused for every expression
+  int line = 0;         //Source line of the statement being generated
+};
+
+//The instruction for every ExprKind, EXPR_OPS[kind]. Leaves are copied
+static const IrOp EXPR_OPS[] = { COPY_ir, COPY_ir, COPY_ir, NEG_ir, ADD_ir, SUB_ir, MULT_ir, DIV_ir };
+
+static void genNode(IrGenObj& irObj, const NodeId NODE);
+static int firstLine(const IrGenObj& IROBJ, const NodeId NODE);
+
+//Conditional and iteration
+static void cond(IrGenObj& irObj, const NodeId NODE);
+static void iter(IrGenObj& irObj, const NodeId NODE);
+static Relation genCompare(IrGenObj& irObj, const NodeId NODE, IrArg& left, IrArg& right);
+static Relation getRelation(const TokenKind relatOp);
+static void endTest(IrGenObj& irObj, const uint32_t TEST, const Relation RELATION, const IrArg LEFT, const IrArg RIGHT,
+                    const uint32_t BODY, const uint32_t OTHER);
+
+//Expression nodes
+static ExprId prepareExp(IrGenObj& irObj, const NodeId NODE);
+static IrArg genExpr(IrGenObj& irObj, const ExprId EXPR, const IrArg DEST);
+static IrArg operandArg(IrGenObj& irObj, const ExprId EXPR);
+
+//Blocks and instructions
+static uint32_t newBlock(IrGenObj& irObj);
+static uint32_t startBlock(IrGenObj& irObj);
+static IrArg newTemp(IrGenObj& irObj);
+static void emit(IrGenObj& irObj, const IrOp OP, const IrArg DEST, const IrArg A, const IrArg B);
+
+
+/*
+ * Description: Lowers the parse tree at ROOT to three address code (ir.h). Every <exp> is folded first (expr.h) when
+ *              FOLD is set and its temps are made in the order the accumulator target works them out best
+ *              (labelTemps), the subexpression that has to be saved is made first.
+ *              <cond> ends its block with a CBR_tm to the <stat> or past it, <iter> gets a block of its own for the
+ *              test that the end of its <stat> goes back to.
+ * Passed:      The parse tree, its root, the symbol table its tokens were interned in and if expressions are folded.
+ * Returns:     The program as basic blocks of three address code.
+ */
+IrProgram genIr(const Tree& TREE, const NodeId ROOT, SymbolTable& symbols, const bool FOLD)
+{
+  IrGenObj irObj = { TREE, symbols, FOLD, {}, 0 };
+  irObj.program.temps = 0;
+  irObj.program.blocks.emplace_back();
+  
+  genNode(irObj, ROOT);
+  irObj.program.blocks[irObj.current].term = STOP_tm;
+  
+  return std::move(irObj.program);
+}
+
+/*
+ * Description: Adds the three address code of NODE to the current block. Nodes are expected to have the child(1|2|3|4)
+ *              be in order of appearnce for that specific node based on the BNF.
+ * Passed:      irObj -> the tree and the program being built | NODE -> root of the parse tree
+ */
+static void genNode(IrGenObj& irObj, const NodeId NODE)
+{
+  if(NODE == NO_NODE) return;
+  
+  //<program> -> program <vars> <block>
+  if(irObj.tree[NODE].kind == PROGRAM_nd) //NO CODE GEN
+  {
+    //We don't care about vars here that was handled when making the semantic table
+    genNode(irObj, irObj.tree[NODE].child2);
+    return;
+  }
+  //<stats> -> <stat> <mStat>
+  else if(irObj.tree[NODE].kind == STATS_nd) //NO CODE GEN
+  {
+    //Every <stat> of the <mStat> chain is linked from the first one
+    for(NodeId stat = irObj.tree[NODE].child1; stat != NO_NODE; stat = irObj.tree[stat].next)
+      genNode(irObj, stat); //<stat>
+    return;
+  }
+  //<stat> -> <read> | <print> | <block> | <cond> | <iter> | <assign>
+  else if(irObj.tree[NODE].kind == STAT_nd) //NO CODE GEN
+  {
+    irObj.line = firstLine(irObj, irObj.tree[NODE].child1); //Every instruction of the statement is made for its line
+    genNode(irObj, irObj.tree[NODE].child1); //<read> | <print> | <block> | <cond> | <iter> | <assign>
+    return;
+  }
+  //<block> -> start <vars> <stats> stop
+  else if(irObj.tree[NODE].kind == BLOCK_nd) //NO CODE GEN
+  {
+    //We don't care about vars here that was handled when making the semantic table
+    genNode(irObj, irObj.tree[NODE].child2); //<stats>
+    return;
+  }
+  //<read> -> read identifier ;
+  else if(irObj.tree[NODE].kind == READ_nd)
+  {
+    emit(irObj, READ_ir, symbolArg(irObj.tree[NODE].tokens[0].symbol), noArg(), noArg());
+    return;
+  }
+  //<print> -> print <exp> ;
+  else if(irObj.tree[NODE].kind == PRINT_nd)
+  {
+    irObj.exprs.clear();
+    ExprId exp = prepareExp(irObj, irObj.tree[NODE].child1); //<exp>
+    emit(irObj, WRITE_ir, noArg(), genExpr(irObj, exp, noArg()), noArg());
+    return;
+  }
+  else if(irObj.tree[NODE].kind == COND_nd)
+  {
+    cond(irObj, NODE);
+    return;
+  }
+  else if(irObj.tree[NODE].kind == ITER_nd)
+  {
+    iter(irObj, NODE);
+    return;
+  }
+  //<assign> -> set identifier <exp> ;
+  else if(irObj.tree[NODE].kind == ASSIGN_nd)
+  {
+    irObj.exprs.clear();
+    ExprId exp = prepareExp(irObj, irObj.tree[NODE].child1); //<exp>
+    genExpr(irObj, exp, symbolArg(irObj.tree[NODE].tokens[0].symbol)); //The last instruction sets the variable
+    return;
+  }
+  
+  //If we get here someone broke the parser
+  std::cout << "SOMEONE BROKE THE PARSER NODE LABEL IS: " << NODE_NAMES[irObj.tree[NODE].kind] << std::endl;
+}
+
+//Description: Returns the line of the first token NODE holds, or of the first one its first children hold
+static int firstLine(const IrGenObj& IROBJ, const NodeId NODE)
+{
+  for(NodeId node = NODE; node != NO_NODE; node = IROBJ.tree[node].child1)
+    if(IROBJ.tree[node].tokenCount > 0) return IROBJ.tree[node].tokens[0].line;
+  return 0;
+}
+
+
+
+/////////////////////////conditional + iteration/////////////////////////////////////////////
+/* Description: Handles <cond> and creates a c style if wihout else. The test ends the current block and goes to
+ *              the block of the <stat> when it holds, otherwise to the block after the <stat>.
+ * Passed: irObj -> the tree and the program being built | NODE -> the <cond> node in the tree
+ * <cond> -> iff [ <exp> <relational> <exp> ] <stat>
+ */
+static void cond(IrGenObj& irObj, const NodeId NODE)
+{
+  IrArg left, right;
+  Relation relation = genCompare(irObj, NODE, left, right);
+  uint32_t test = irObj.current;
+  
+  uint32_t body = newBlock(irObj);
+  genNode(irObj, irObj.tree[NODE].child4); //<stat>
+  uint32_t join = newBlock(irObj);
+  
+  endTest(irObj, test, relation, left, right, body, join);
+}
+
+/* Description: Handles <iter> and creates a c style while loop. The test gets a block of its own, it goes to the
+ *              block of the <stat> when it holds, otherwise past the loop. The end of the <stat> goes back to the test.
+ * Passed: irObj -> the tree and the program being built | NODE -> the <iter> node in the tree
+ * <iter> -> iterate [ <exp> <relational> <exp> ] <stat>
+ */
+static void iter(IrGenObj& irObj, const NodeId NODE)
+{
+  uint32_t test = startBlock(irObj);
+  IrArg left, right;
+  Relation relation = genCompare(irObj, NODE, left, right);
+  
+  uint32_t body = newBlock(irObj);
+  genNode(irObj, irObj.tree[NODE].child4); //<stat>
+  uint32_t bodyEnd = irObj.current;
+  uint32_t exit = newBlock(irObj);
+  
+  irObj.program.blocks[bodyEnd].target = test;
+  endTest(irObj, test, relation, left, right, body, exit);
+}
+
+/* Description: Works out both <exp> of a <cond> or <iter> into the current block. The right <exp> is worked
+ *              out first unless it is a variable or integer.
+ * Passed: irObj -> the tree and the program being built | NODE -> the <cond> or <iter> node in the tree |
+ *         where to save the left and right side of the relation
+ * Returns: The relation to test
+ */
+static Relation genCompare(IrGenObj& irObj, const NodeId NODE, IrArg& left, IrArg& right)
+{
+  irObj.exprs.clear();
+  ExprId rightExp = prepareExp(irObj, irObj.tree[NODE].child3);
+  ExprId leftExp = prepareExp(irObj, irObj.tree[NODE].child1);
+  
+  if(isOperand(irObj.exprs, rightExp))
+  {
+    left = genExpr(irObj, leftExp, noArg());
+    right = operandArg(irObj, rightExp);
+  }
+  else
+  {
+    right = genExpr(irObj, rightExp, noArg());
+    left = genExpr(irObj, leftExp, noArg());
+  }
+  
+  //The test ends the current block, the statement inside it has not changed the line yet
+  irObj.program.blocks[irObj.current].line = irObj.line;
+  return getRelation(irObj.tree[irObj.tree[NODE].child2].tokens[0].kind);
+}
+
+//Description: Returns the relation of the relational token relatOp
+static Relation getRelation(const TokenKind relatOp)
+{
+  if(relatOp == LESSEQUAL_tk) return LE_rel;    // <=
+  if(relatOp == LESSTHAN_tk) return LT_rel;     // <
+  if(relatOp == GREATEREQUAL_tk) return GE_rel; // >=
+  if(relatOp == GREATERTHAN_tk) return GT_rel;  // >
+  if(relatOp == TILDE_tk) return NE_rel;        // !=
+  return EQ_rel;                                // ==
+}
+
+//Description: Ends the block TEST with a CBR_tm that goes to BODY when LEFT RELATION RIGHT holds, otherwise to OTHER
+static void endTest(IrGenObj& irObj, const uint32_t TEST, const Relation RELATION, const IrArg LEFT, const IrArg RIGHT,
+                    const uint32_t BODY, const uint32_t OTHER)
+{
+  IrBlock& block = irObj.program.blocks[TEST];
+  block.term = CBR_tm;
+  block.rel = RELATION;
+  block.a = LEFT;
+  block.b = RIGHT;
+  block.target = BODY;
+  block.other = OTHER;
+}
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+//////////////////////////Expression//////////////////////////////////////////////////////////
+/*
+ * Description: Builds the <exp> NODE into irObj.exprs, folds it unless irObj.fold is off and numbers its temps
+ *              (expr.h).
+ *              Nothing is cleared so a statement can prepare both sides of a condition at once.
+ * Passed: irObj -> the tree and the program being built | NODE -> the <exp> node in the tree
+ * Returns: The root of the prepared expression
+ * <exp>  -> <M> <exp2>
+ * <exp2> -> + <exp> | - <exp> | empty
+ */
+static ExprId prepareExp(IrGenObj& irObj, const NodeId NODE)
+{
+  ExprId root = buildExpr(irObj.tree, NODE, irObj.exprs, irObj.symbols);
+  if(irObj.fold) root = foldExpr(irObj.exprs, root);
+  labelTemps(irObj.exprs, root);
+  
+  return root;
+}
+
+/*
+ * Description: Adds the instructions of a prepared expression to the current block. A variable or integer is not worked
+ *              out, it is used as the operand. Otherwise the subexpression that has to be saved is worked out first,
+ *              see labelTemps in expr.h.
+ * Passed: irObj -> the tree and the program being built | EXPR -> the expression node in irObj.exprs |
+ *         DEST -> the variable the value goes to or noArg() for a new temp
+ * Returns: Where the value is, DEST if it was given
+ */
+static IrArg genExpr(IrGenObj& irObj, const ExprId EXPR, const IrArg DEST)
+{
+  const Expr expr = irObj.exprs[EXPR];
+  IrArg a, b;
+  
+  if(expr.kind == CONST_ex || expr.kind == VAR_ex)
+  {
+    if(DEST.kind == NONE_ia) return operandArg(irObj, EXPR);
+    a = operandArg(irObj, EXPR);
+    b = noArg();
+  }
+  else if(expr.kind == LITERAL_ex) //Too big to be a operand, always copied first
+  {
+    a = symbolArg(expr.symbol);
+    b = noArg();
+  }
+  else if(expr.kind == NEG_ex) // - <N>
+  {
+    a = genExpr(irObj, expr.left, noArg());
+    b = noArg();
+  }
+  else if(isOperand(irObj.exprs, expr.right)) //<left> op operand
+  {
+    a = genExpr(irObj, expr.left, noArg());
+    b = operandArg(irObj, expr.right);
+  }
+  else if(isOperand(irObj.exprs, expr.left) && expr.kind != DIV_ex) //operand op <right>
+  {
+    a = operandArg(irObj, expr.left);
+    b = genExpr(irObj, expr.right, noArg());
+  }
+  else if(spillLeft(irObj.exprs, EXPR)) //+ and % can go either way, do the bigger side first
+  {
+    a = genExpr(irObj, expr.left, noArg());
+    b = genExpr(irObj, expr.right, noArg());
+  }
+  else
+  {
+    b = genExpr(irObj, expr.right, noArg());
+    a = genExpr(irObj, expr.left, noArg());
+  }
+  
+  IrArg dest = DEST.kind == NONE_ia ? newTemp(irObj) : DEST;
+  emit(irObj, EXPR_OPS[expr.kind], dest, a, b);
+  return dest;
+}
+
+//Description: Returns the argument of the variable or integer EXPR
+static IrArg operandArg(IrGenObj& irObj, const ExprId EXPR)
+{
+  const Expr& expr = irObj.exprs[EXPR];
+  if(expr.kind == CONST_ex) return intArg(expr.value);
+  
+  return symbolArg(expr.symbol);
+}
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Description: Ends the current block by falling through to a new empty block that becomes the current block.
+ * Passed: The program being built
+ * Returns: The number of the new block
+ */
+static uint32_t newBlock(IrGenObj& irObj)
+{
+  uint32_t block = irObj.program.blocks.size();
+  irObj.program.blocks[irObj.current].term = JUMP_tm;
+  irObj.program.blocks[irObj.current].target = block;
+  
+  irObj.program.blocks.emplace_back();
+  irObj.current = block;
+  return block;
+}
+
+//Description: Returns a block branches can go to that starts here, the current block if it is still empty
+static uint32_t startBlock(IrGenObj& irObj)
+{
+  if(irObj.program.blocks[irObj.current].instrs.empty()) return irObj.current;
+  
+  return newBlock(irObj);
+}
+
+//Description: Makes a new temp
+static IrArg newTemp(IrGenObj& irObj)
+{
+  return tempArg(irObj.program.temps++);
+}
+
+//Description: Adds dest = OP A, B to the current block, made for the line of the statement
+static void emit(IrGenObj& irObj, const IrOp OP, const IrArg DEST, const IrArg A, const IrArg B)
+{
+  irObj.program.blocks[irObj.current].instrs.push_back({ OP, DEST, A, B, irObj.line });
+}
\ No newline at end of file
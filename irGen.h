@@ -0,0 +1,19 @@
+#ifndef IRGEN_H
+#define IRGEN_H
+
+#include "tree.h"
+#include "symbols.h"
+#include "ir.h"
+
+/*
+ * Description: Lowers the parse tree at ROOT to three address code (ir.h). Every <exp> is folded first (expr.h) when
+ *              FOLD is set and its temps are made in the order the accumulator target works them out best
+ *              (labelTemps), the subexpression that has to be saved is made first.
+ *              <cond> ends its block with a CBR_tm to the <stat> or past it, <iter> gets a block of its own for the
+ *              test that the end of its <stat> goes back to.
+ * Passed:      The parse tree, its root, the symbol table its tokens were interned in and if expressions are folded.
+ * Returns:     The program as basic blocks of three address code.
+ */
+IrProgram genIr(const Tree& TREE, const NodeId ROOT, SymbolTable& symbols, const bool FOLD = true);
+
+#endif
\ No newline at end of file
@@ -1,13 +1,23 @@
 #include "language.h"
 
-Token::Token(const std::string& tokenId, const std::string& instance, int line)
-      : tokenId(tokenId), instance(instance), line(line) {}
+Token::Token(TokenKind kind, Keyword keyword, uint32_t symbol, int line, int col)
+      : kind(kind), keyword(keyword), symbol(symbol), line(line), col(col) {}
 
 Token::Token()
-      : tokenId(""), instance(""), line(0) {}
+      : kind(EOF_tk), keyword(NOT_kw), symbol(0), line(0), col(0) {}
 
 
-const std::map<char, int> COLMAP = {
+/*
+ * The map from characters to STATE_TABLE columns the scanner used before CHARCLASS, kept as it was written so the
+ * table built from COLUMN_CHARS is checked against it on every build. Characters missing from it are not in the
+ * language.
+ */
+struct ColmapEntry {
+  char c;
+  int col;
+};
+
+constexpr ColmapEntry COLMAP[] = {
   {'e', 0},
   {'g', 1},
   {'l', 2},
@@ -50,19 +60,29 @@ const std::map<char, int> COLMAP = {
   {'@', 25}
 };
 
-const int STATE_TABLE[STATES][COLCHARS] = {
-  {  10,   10,   10,   10,    1,  105,  106,  107,  108,  109,    8,  111,  112,  113,  114,  115,  116,  117,  118,  119,  120, 1001,    0,    9,   10,    0},
-  {1002,    5,    2, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002,    1},
-  {   3, 1000, 1000,    4, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    2},
-  {1000, 1000, 1000, 1000,  101, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    3},
-  {1000, 1000, 1000, 1000,  102, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    4},
-  {   6, 1000, 1000,    7, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    5},
-  {1000, 1000, 1000, 1000,  103, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    6},
-  {1000, 1000, 1000, 1000,  104, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    7},
-  {1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001,  110, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1000, 1001, 1001,    8},
-  { 121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,    9,  121,    9},
-  {  10,   10,   10,   10,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,   10,  122,   10,   10,   10}
-};
+//Column COLMAP gives the byte C, ILLEGAL_CHAR where COLMAP.at threw out_of_range
+constexpr int colmapClass(const unsigned char C)
+{
+  for(const ColmapEntry& entry : COLMAP)
+    if(static_cast<unsigned char>(entry.c) == C) return entry.col;
+  
+  return ILLEGAL_CHAR;
+}
+
+//Checks CHARCLASS gives every one of the 256 byte values the column COLMAP did
+constexpr bool matchesColmap()
+{
+  for(int c = 0; c < 256; c++)
+    if(CHARCLASS[c] != colmapClass(c)) return false;
+  
+  return true;
+}
+
+static_assert(matchesColmap(), "CHARCLASS has to match COLMAP for every byte");
+static_assert(CHARCLASS['e'] == 0 && CHARCLASS['_'] == 21 && CHARCLASS['\r'] == 22 && CHARCLASS['@'] == 25,
+              "CHARCLASS columns moved");
+static_assert(CHARCLASS[0] == ILLEGAL_CHAR && CHARCLASS['!'] == ILLEGAL_CHAR && CHARCLASS[0xff] == ILLEGAL_CHAR,
+              "Characters not in the language have no column");
 
 
 const std::map<int, std::string> ERRORS = {
@@ -73,30 +93,18 @@ const std::map<int, std::string> ERRORS = {
   {1004, "LEXICAL ERROR: Invalid Comment | Line: "}
 };
 
-const std::map<int, std::string> TOKENS = {
-  {100, "PERIOD_tk"},
-  {101, "LESSEQUAL_tk"},
-  {102, "LESSTHAN_tk"},
-  {103, "GREATEREQUAL_tk"},
-  {104, "GREATERTHAN_tk"},
-  {105, "TILDE_tk"},
-  {106, "COLON_tk"},
-  {107, "SEMICOLON_tk"},
-  {108, "PLUS_tk"},
-  {109, "MINUS_tk"},
-  {110, "ASTERISK_tk"},
-  {111, "FORWARDSLASH_tk"},
-  {112, "PERCENT_tk"},
-  {113, "LEFTPAREN_tk"},
-  {114, "RIGHTPAREN_tk"},
-  {115, "COMMA_tk"},
-  {116, "LEFTCURLY_tk"},
-  {117, "RIGHTCURLY_tk"},
-  {118, "LEFTBRACKET_tk"},
-  {119, "RIGHTBRACKET_tk"},
-  {120, "EQUALS_TK"},
-  {121, "INT_tk"},
-  {122, "ID_tk"}
+const char* const TOKEN_NAMES[TOKENKINDS] = {
+  "EOF_tk", "KEYWORD_tk", "ID_tk", "INT_tk",
+  "PERIOD_tk", "LESSEQUAL_tk", "LESSTHAN_tk", "GREATEREQUAL_tk", "GREATERTHAN_tk", "TILDE_tk", "COLON_tk", "SEMICOLON_tk",
+  "PLUS_tk", "MINUS_tk", "ASTERISK_tk", "FORWARDSLASH_tk", "PERCENT_tk", "LEFTPAREN_tk", "RIGHTPAREN_tk", "COMMA_tk",
+  "LEFTCURLY_tk", "RIGHTCURLY_tk", "LEFTBRACKET_tk", "RIGHTBRACKET_tk", "EQUALS_TK"
+};
+
+const char* const TOKEN_TEXT[TOKENKINDS] = {
+  "EOF", "", "", "",
+  ".", ".le.", ".lt.", ".ge.", ".gt.", "~", ":", ";",
+  "+", "-", "**", "/", "%", "(", ")", ",",
+  "{", "}", "[", "]", "="
 };
 
-const std::unordered_set<std::string> KEYWORDS = {"start",  "stop", "iterate", "var", "exit", "read", "print", "iff", "then", "set", "func", "program"};
+const char* const KEYWORD_TEXT[KEYWORDSIZE] = {"start",  "stop", "iterate", "var", "exit", "read", "print", "iff", "then", "set", "func", "program"};
@@ -2,34 +2,131 @@
 #define LANGUAGE_H
 
 #include <map>
-#include <unordered_set>
+#include <array>
+#include <cstdint>
+#include <string>
 
 #define STATES 11   //How many states in the FSA
 #define COLCHARS 26 //How many specific char cases there are for the FSA
 
+//Every type of token the scanner can build
+enum TokenKind : uint8_t {
+  EOF_tk, KEYWORD_tk, ID_tk, INT_tk,
+  PERIOD_tk, LESSEQUAL_tk, LESSTHAN_tk, GREATEREQUAL_tk, GREATERTHAN_tk, TILDE_tk, COLON_tk, SEMICOLON_tk,
+  PLUS_tk, MINUS_tk, ASTERISK_tk, FORWARDSLASH_tk, PERCENT_tk, LEFTPAREN_tk, RIGHTPAREN_tk, COMMA_tk,
+  LEFTCURLY_tk, RIGHTCURLY_tk, LEFTBRACKET_tk, RIGHTBRACKET_tk, EQUALS_TK,
+  TOKENKINDS //How many token types there are
+};
+
+const int KEYWORDSIZE = 12; //How many keywords are in the language
+
+//Every keyword in the language. The order matches KEYWORD_TEXT so a keyword is also its symbol ID.
+enum Keyword : uint8_t {
+  START_kw, STOP_kw, ITERATE_kw, VAR_kw, EXIT_kw, READ_kw, PRINT_kw, IFF_kw, THEN_kw, SET_kw, FUNC_kw, PROGRAM_kw,
+  NOT_kw //Token is not a keyword
+};
+
 //Defines a token
 struct Token {
-  std::string tokenId;  //What type of token this is
-  std::string instance; //What is the token actually
-  int line;             //What line the token is on
+  TokenKind kind;  //What type of token this is
+  Keyword keyword; //Which keyword this is when kind is KEYWORD_tk
+  uint32_t symbol; //Symbol ID of what the token actually is (symbols.h)
+  int line;        //What line the token is on
+  int col;         //What column the token starts on
   
-  Token(const std::string& tokenId, const std::string& instance, int line);
+  Token(TokenKind kind, Keyword keyword, uint32_t symbol, int line, int col);
   Token();
 };
 
-//A map that relates passed characters to a specific column in the STATE_TABLE
-extern const std::map<char, int> COLMAP;
+//The name of every token type, TOKEN_NAMES[kind]
+extern const char* const TOKEN_NAMES[TOKENKINDS];
+
+//The text of every token type that is always spelled the same, "" for ID_tk, INT_tk and KEYWORD_tk
+extern const char* const TOKEN_TEXT[TOKENKINDS];
+
+//The text of every keyword, KEYWORD_TEXT[keyword]
+extern const char* const KEYWORD_TEXT[KEYWORDSIZE];
+
+//The characters belonging to each column of the STATE_TABLE, column i is for the characters in COLUMN_CHARS[i]
+constexpr const char* COLUMN_CHARS[COLCHARS] = {
+  "e", "g", "l", "t", ".", "~", ":", ";", "+", "-", "*", "/", "%", "(", ")", ",", "{", "}", "[", "]", "=", "_",
+  " \n\t\r",                                        //White space
+  "0123456789",                                       //Digits
+  "abcdfhijkmnopqrsuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", //Rest of the letters
+  "@"                                                 //Comments
+};
+
+const int8_t ILLEGAL_CHAR = -1; //Class of every character that is not in the language
+
+/*
+ * Builds a table relating every byte value to its column in the STATE_TABLE from COLUMN_CHARS.
+ * Characters not in the language are ILLEGAL_CHAR.
+ */
+constexpr std::array<int8_t, 256> buildCharClass()
+{
+  std::array<int8_t, 256> table = {};
+  for(int i = 0; i < 256; i++) table[i] = ILLEGAL_CHAR;
+  
+  for(int col = 0; col < COLCHARS; col++)
+    for(const char* c = COLUMN_CHARS[col]; *c != '\0'; c++)
+      table[static_cast<unsigned char>(*c)] = col;
+  
+  return table;
+}
+
+//Relates every byte value to a specific column in the STATE_TABLE, built at compile time
+constexpr std::array<int8_t, 256> CHARCLASS = buildCharClass();
+
+//Column in the STATE_TABLE for a character, ILLEGAL_CHAR if the character is not in the language
+inline int charClass(const char C)
+{
+  return CHARCLASS[static_cast<unsigned char>(C)];
+}
 
 //A map holding all the error messages depending on the error state
 extern const std::map<int, std::string> ERRORS;
 
-extern const int STATE_TABLE[STATES][COLCHARS]; //A state table relating to the DFSA for this language
-
-const int KEYWORDSIZE = 12; //How many keywords are in the language
-//An unordered_set holding the string representation of every keyword
-extern const std::unordered_set<std::string> KEYWORDS;
+//A state table relating to the DFSA for this language. Known at compile time so the direct scanner (scanner.h) can
+//be built from it
+constexpr int STATE_TABLE[STATES][COLCHARS] = {
+  {  10,   10,   10,   10,    1,  105,  106,  107,  108,  109,    8,  111,  112,  113,  114,  115,  116,  117,  118,  119,  120, 1001,    0,    9,   10,    0},
+  {1002,    5,    2, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002, 1002,    1},
+  {   3, 1000, 1000,    4, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    2},
+  {1000, 1000, 1000, 1000,  101, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    3},
+  {1000, 1000, 1000, 1000,  102, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    4},
+  {   6, 1000, 1000,    7, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    5},
+  {1000, 1000, 1000, 1000,  103, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    6},
+  {1000, 1000, 1000, 1000,  104, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000,    7},
+  {1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001,  110, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1001, 1000, 1001, 1001,    8},
+  { 121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,  121,    9,  121,    9},
+  {  10,   10,   10,   10,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,  122,   10,  122,   10,   10,   10}
+};
 
-//A map that relates a final state to a specific token
-extern const std::map<int, std::string> TOKENS;
+//Relates a final state to a specific token, FINAL_TOKENS[state - 100]
+constexpr TokenKind FINAL_TOKENS[23] = {
+  PERIOD_tk,       //100
+  LESSEQUAL_tk,    //101
+  LESSTHAN_tk,     //102
+  GREATEREQUAL_tk, //103
+  GREATERTHAN_tk,  //104
+  TILDE_tk,        //105
+  COLON_tk,        //106
+  SEMICOLON_tk,    //107
+  PLUS_tk,         //108
+  MINUS_tk,        //109
+  ASTERISK_tk,     //110
+  FORWARDSLASH_tk, //111
+  PERCENT_tk,      //112
+  LEFTPAREN_tk,    //113
+  RIGHTPAREN_tk,   //114
+  COMMA_tk,        //115
+  LEFTCURLY_tk,    //116
+  RIGHTCURLY_tk,   //117
+  LEFTBRACKET_tk,  //118
+  RIGHTBRACKET_tk, //119
+  EQUALS_TK,       //120
+  INT_tk,          //121
+  ID_tk            //122
+};
 
 #endif
\ No newline at end of file
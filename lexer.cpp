@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "lexer.h"
+#include "threadPool.h"
+
+const size_t CHUNK_BYTES = 1 << 16; //Fewest bytes worth scanning on a thread of its own
+
+//A piece of the buffer that is scanned on its own
+struct Chunk {
+  const char* begin;                    //First character, the one after a newline
+  const char* end;                      //One past the newline the chunk ends with, end of the buffer for the last
+  int line;                             //Line the chunk starts on
+  std::vector<Token> tokens;            //The tokens that start in the chunk, then the first one of the next chunk
+  const char* first = nullptr;          //Where the first token starts
+  const char* last = nullptr;           //Where the last token starts
+  std::string error;                    //The lexical error after the tokens, empty if there is none
+  std::unique_ptr<SymbolTable> symbols; //Where the chunk interns, every chunk but the first has its own
+  std::unique_ptr<ScannerIn> scannerIn; //The scanner of the chunk, kept to carry on after the last token
+};
+
+static void planChunks(const char* begin, const char* end, const size_t COUNT, const SkipKernels& SKIP,
+                       std::vector<Chunk>& chunks);
+static void scanChunk(Chunk& chunk, const char* end, SymbolTable& symbols, const ScannerBackend BACKEND);
+static bool continues(const Chunk& PREVIOUS, const SymbolTable& PREVIOUSSYMBOLS, const Chunk& CHUNK,
+                      const SymbolTable& SYMBOLS);
+static void append(const Token* begin, const Token* end, const SymbolTable* chunkSymbols, SymbolTable& symbols,
+                   TokenStream& stream);
+static void scanRest(ScannerIn& scannerIn, TokenStream& stream);
+
+
+void lexChunks(const char* begin, const char* end, SymbolTable& symbols, const ScannerBackend BACKEND,
+               const size_t THREADS, TokenStream& stream)
+{
+  size_t threads = THREADS == 0 ? std::thread::hardware_concurrency() : THREADS;
+  size_t count = std::min(std::max<size_t>(threads, 1), static_cast<size_t>(end - begin) / CHUNK_BYTES + 1);
+  
+  std::vector<Chunk> chunks;
+  planChunks(begin, end, count, skipKernels(bestSkipLevel()), chunks);
+  
+  //The first chunk interns straight into symbols, nothing it interns can come after what the others intern
+  for(size_t i = 1; i < chunks.size(); i++) chunks[i].symbols.reset(new SymbolTable);
+  ThreadPool pool(chunks.size());
+  pool.run(chunks.size(), [&](size_t i)
+  {
+    scanChunk(chunks[i], end, i == 0 ? symbols : *chunks[i].symbols, BACKEND);
+  });
+  
+  //A chunk ends with the first token of the next one, if the next chunk starts with the same token it was scanned
+  //from where the scanner would be, if not the rest is scanned on from the end of the chunk before it
+  for(size_t i = 0; i < chunks.size(); i++)
+  {
+    const Chunk& chunk = chunks[i];
+    const SymbolTable* chunkSymbols = chunk.symbols.get();
+    bool carries = chunk.error.empty() && chunk.tokens.back().kind != EOF_tk; //Ends in the next chunk
+    append(chunk.tokens.data(), chunk.tokens.data() + chunk.tokens.size() - carries, chunkSymbols, symbols, stream);
+    if(!carries)
+    {
+      stream.error = chunk.error;
+      return;
+    }
+    
+    const Chunk& next = chunks[i + 1];
+    if(!continues(chunk, chunkSymbols ? *chunkSymbols : symbols, next, *next.symbols))
+    {
+      append(&chunk.tokens.back(), &chunk.tokens.back() + 1, chunkSymbols, symbols, stream);
+      ScannerIn rest(chunk.scannerIn->current, end, symbols, BACKEND);
+      rest.line = chunk.scannerIn->line;
+      rest.lineStart = chunk.scannerIn->lineStart;
+      scanRest(rest, stream);
+      return;
+    }
+  }
+}
+
+/*
+ * Description: Splits the buffer into up to COUNT chunks of about the same size, every chunk but the first starts
+ *              after a newline. The line a chunk starts on counts every newline before it, a newline in a comment is
+ *              not counted by the scanner so the chunk after one does not continue the one before (continues).
+ * Passed:      The buffer, how many chunks to make, the kernels to look through it with and where to save them
+ */
+static void planChunks(const char* begin, const char* end, const size_t COUNT, const SkipKernels& SKIP,
+                       std::vector<Chunk>& chunks)
+{
+  chunks.resize(1);
+  chunks[0].begin = begin;
+  chunks[0].end = end;
+  chunks[0].line = 1;
+  
+  int line = 1;
+  for(size_t i = 1; i < COUNT; i++)
+  {
+    const char* split = SKIP.findByte(std::max(begin + (end - begin) * i / COUNT, chunks.back().begin), end, '\n');
+    if(split == end || split + 1 == end) break;
+    
+    const char* lineStart;
+    line += SKIP.countLines(chunks.back().begin, ++split, lineStart);
+    chunks.back().end = split;
+    chunks.emplace_back();
+    chunks.back().begin = split;
+    chunks.back().end = end;
+    chunks.back().line = line;
+  }
+}
+
+/*
+ * Description: Scans the tokens that start in CHUNK and the first one that starts after it, or up to the end of the
+ *              buffer or a lexical error. The scanner reads on to the end of the buffer so what follows the chunk is
+ *              looked ahead at as usual. The scanner is kept in the chunk for carrying on after it.
+ * Passed:      The chunk, the end of the buffer, the table to intern into and the backend to scan with
+ */
+static void scanChunk(Chunk& chunk, const char* end, SymbolTable& symbols, const ScannerBackend BACKEND)
+{
+  chunk.scannerIn.reset(new ScannerIn(chunk.begin, end, symbols, BACKEND));
+  ScannerIn& scannerIn = *chunk.scannerIn;
+  scannerIn.line = chunk.line;
+  try
+  {
+    while(true)
+    {
+      Token token = scanner(scannerIn);
+      chunk.last = scannerIn.lineStart + token.col - 1; //Where the token text starts
+      if(chunk.tokens.empty()) chunk.first = chunk.last;
+      chunk.tokens.push_back(token);
+      if(token.kind == EOF_tk || chunk.last >= chunk.end) break;
+    }
+  }
+  catch(const std::invalid_argument &e) //Lexical error
+  {
+    chunk.error = e.what();
+  }
+}
+
+/*
+ * Description: Checks if CHUNK starts with the token PREVIOUS ends with, at the same place, line and column. From the
+ *              start of that token on the scanner of each chunk reads the same way so the rest of CHUNK is what the
+ *              scanner builds after PREVIOUS.
+ * Passed:      The chunk before CHUNK, the tables they interned into and the chunk
+ * Returns:     True if CHUNK continues PREVIOUS
+ */
+static bool continues(const Chunk& PREVIOUS, const SymbolTable& PREVIOUSSYMBOLS, const Chunk& CHUNK,
+                      const SymbolTable& SYMBOLS)
+{
+  if(CHUNK.tokens.empty() || PREVIOUS.last != CHUNK.first) return false;
+  
+  const Token& carried = PREVIOUS.tokens.back();
+  const Token& first = CHUNK.tokens.front();
+  return carried.kind == first.kind && carried.keyword == first.keyword && carried.line == first.line &&
+         carried.col == first.col && PREVIOUSSYMBOLS.text(carried.symbol) == SYMBOLS.text(first.symbol);
+}
+
+/*
+ * Description: Appends the tokens from begin up to end to stream, with their symbols interned into symbols in order
+ *              when they are from a chunk with its own table.
+ * Passed:      The tokens, the table of their chunk, null if it is symbols, the table of the buffer and the stream
+ */
+static void append(const Token* begin, const Token* end, const SymbolTable* chunkSymbols, SymbolTable& symbols,
+                   TokenStream& stream)
+{
+  if(chunkSymbols == nullptr)
+  {
+    stream.tokens.insert(stream.tokens.end(), begin, end);
+    return;
+  }
+  
+  std::vector<uint32_t> symbolIds(chunkSymbols->size(), UINT32_MAX); //Symbol in symbols of every chunk symbol
+  for(const Token* token = begin; token != end; token++)
+  {
+    uint32_t& id = symbolIds[token->symbol];
+    if(id == UINT32_MAX) id = symbols.intern(chunkSymbols->text(token->symbol));
+    stream.tokens.push_back(*token);
+    stream.tokens.back().symbol = id;
+  }
+}
+
+//Scans the rest of the buffer one token at a time into stream, like the parser would
+static void scanRest(ScannerIn& scannerIn, TokenStream& stream)
+{
+  try
+  {
+    do
+    {
+      stream.tokens.push_back(scanner(scannerIn));
+    } while(stream.tokens.back().kind != EOF_tk);
+  }
+  catch(const std::invalid_argument &e) //Lexical error
+  {
+    stream.error = e.what();
+  }
+}
\ No newline at end of file
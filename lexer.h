@@ -0,0 +1,22 @@
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <cstddef>
+
+#include "scanner.h"
+#include "symbols.h"
+
+/*
+ * Definition: Scans the whole buffer from begin to end into stream before the parser reads it. A buffer big enough is
+ *             split after newlines into a chunk per thread and every chunk is scanned at once from the line it starts
+ *             on. Tokens don't go past a newline outside a comment so a chunk almost always starts where the scanner
+ *             would, each one is checked against the end of the one before and the rest is scanned one token at a
+ *             time from there when it does not. The symbols of the chunks are interned into symbols in file order,
+ *             stream holds the same tokens and the same first lexical error as scanning the buffer one at a time.
+ * Passed:     The buffer, the table to intern into, the backend to scan with, how many threads to scan on (0 is one
+ *             per core) and the stream to fill
+ */
+void lexChunks(const char* begin, const char* end, SymbolTable& symbols, const ScannerBackend BACKEND,
+               const size_t THREADS, TokenStream& stream);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,595 @@
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "loop.h"
+
+const uint32_t NO_BLOCK = UINT32_MAX; //Dominator of a block that can not be reached
+const uint32_t NO_LOOP = UINT32_MAX;  //Innermost loop of a block in no loop
+const uint32_t NO_VAR = UINT32_MAX;   //Variable of a temp that has not been given one
+const uint32_t ADD_COST = 3;          //Instructions a add to a variable takes on the target, load add store
+
+//A natural loop
+struct Loop {
+  uint32_t header;                    //Block every iteration starts at
+  uint32_t preheader;                 //Block right before the header everything outside the loop goes through
+  std::vector<uint32_t> latches = {}; //Blocks of the loop that go back to the header
+  std::vector<uint32_t> body = {};    //Every block of the loop in layout order, the header too
+};
+
+/*
+ * Object for the program whose loops are being optimized to be passed throughout the pass.
+ */
+struct LoopObj {
+  IrProgram &program;                            //The program being optimized
+  SemanticTable &table;                          //Variables of the program, _h(num) and _s(num) are added to it
+  LoopReport &report;                            //What has been done
+  std::vector<std::vector<uint32_t>> preds = {}; //Blocks that go to every block
+  std::vector<uint32_t> order = {};              //Reverse post order position of every block, NO_BLOCK if not reached
+  std::vector<uint32_t> idom = {};               //Immediate dominator of every block, NO_BLOCK if not reached
+  std::vector<Loop> loops = {};                  //Every loop, inner loops before the loops they are in
+  std::vector<uint32_t> innermost = {};          //Innermost loop every block is in or NO_LOOP
+  std::vector<char> defined = {};                //If each symbol is set in the loop being optimized
+  std::vector<char> hoistVar = {};               //If each symbol is a variable of this pass only set in a preheader
+  uint32_t vars = 0;                             //How many variables have been made
+};
+
+static void findDominators(LoopObj& loopObj);
+static bool insertPreheaders(LoopObj& loopObj);
+static void findLoops(LoopObj& loopObj);
+static void hoistInvariants(LoopObj& loopObj, const Loop& LOOP);
+static void reduceStrength(LoopObj& loopObj, const uint32_t LOOP);
+static bool isInvariant(const LoopObj& LOOPOBJ, const IrInstr& INSTR, const std::vector<char>& INVARIANT);
+static bool isInvariantArg(const LoopObj& LOOPOBJ, const IrArg& ARG, const std::vector<char>& INVARIANT);
+static void markDefined(LoopObj& loopObj, const Loop& LOOP);
+static void renameTemp(IrArg& arg, const std::vector<uint32_t>& VARS);
+static uint32_t newVar(LoopObj& loopObj, const char PREFIX, const bool SETONCE);
+static bool dominates(const LoopObj& LOOPOBJ, const uint32_t DOMINATOR, uint32_t block);
+static uint32_t successors(const IrBlock& BLOCK, uint32_t succs[2]);
+
+
+/*
+ * Description: Optimizes every loop of PROGRAM, inner loops first. A loop is a header block and the blocks that go back
+ *              to it that the header dominates. Every loop gets a preheader, a block laid out right before its header
+ *              that everything outside the loop goes to the header through.
+ *              - instructions whose arguments do not change in the loop are hoisted into the preheader. This takes
+ *                the right side of the test of a iterate too. A division that could fault is left where it is.
+ *              - a multiplication of a induction variable, one the loop only adds a integer to once per iteration,
+ *                by something the loop does not change becomes a copy of a variable set in the preheader and added to
+ *                after the induction variable is. This is only done when the accumulator target saves more than the
+ *                add costs, which takes more than 3 such multiplications of the same pair.
+ *              Values that now live across blocks are kept in _h(num) and _s(num) variables which are added to the
+ *              semantic table. Empty preheaders are left for simplifyCfg (cfg.h) to remove.
+ * Passed:      The program, its semantic table and the report to count what was done in.
+ */
+void optimizeLoops(IrProgram& program, SemanticTable& table, LoopReport& report)
+{
+  LoopObj loopObj = { program, table, report };
+  
+  findDominators(loopObj);
+  if(!insertPreheaders(loopObj)) return;
+  
+  //The blocks moved, work the dominators and loops out again
+  findDominators(loopObj);
+  findLoops(loopObj);
+  report.loops += loopObj.loops.size();
+  
+  loopObj.innermost.assign(program.blocks.size(), NO_LOOP);
+  for(uint32_t i = 0; i < loopObj.loops.size(); i++)
+  {
+    const Loop& loop = loopObj.loops[i];
+    for(uint32_t block : loop.body)
+    {
+      if(loopObj.innermost[block] == NO_LOOP) loopObj.innermost[block] = i;
+    }
+    
+    hoistInvariants(loopObj, loop);
+    reduceStrength(loopObj, i);
+  }
+}
+
+//Prints how many loops optimizeLoops found and what it did to out
+void printReport(const LoopReport& REPORT, std::ostream& out)
+{
+  out << "Loops: " << REPORT.loops << " loops" << std::endl;
+  out << "  hoisted instructions     " << REPORT.hoisted << std::endl;
+  out << "  reduced multiplications  " << REPORT.reduced << std::endl;
+  out << "  unprofitable to reduce   " << REPORT.unprofitable << std::endl;
+}
+
+/*
+ * Description: Works out the blocks going to every block and the immediate dominator of every block reached from
+ *              block 0 with the iterative algorithm of Cooper, Harvey and Kennedy over reverse post order.
+ * Passed:      The object of the program.
+ */
+static void findDominators(LoopObj& loopObj)
+{
+  const IrProgram& PROGRAM = loopObj.program;
+  size_t count = PROGRAM.blocks.size();
+  uint32_t succs[2];
+  
+  loopObj.preds.assign(count, std::vector<uint32_t>());
+  for(uint32_t i = 0; i < count; i++)
+  {
+    uint32_t succCount = successors(PROGRAM.blocks[i], succs);
+    for(uint32_t s = 0; s < succCount; s++) loopObj.preds[succs[s]].push_back(i);
+  }
+  
+  //Post order from block 0 with a stack of blocks and how many of their successors have been visited
+  std::vector<uint32_t> postOrder;
+  std::vector<char> seen(count, false);
+  std::vector<std::pair<uint32_t, uint32_t>> stack(1, { 0, 0 });
+  seen[0] = true;
+  while(!stack.empty())
+  {
+    uint32_t block = stack.back().first;
+    uint32_t succCount = successors(PROGRAM.blocks[block], succs);
+    if(stack.back().second < succCount)
+    {
+      uint32_t next = succs[stack.back().second++];
+      if(!seen[next])
+      {
+        seen[next] = true;
+        stack.push_back({ next, 0 });
+      }
+      continue;
+    }
+    postOrder.push_back(block);
+    stack.pop_back();
+  }
+  
+  loopObj.order.assign(count, NO_BLOCK);
+  for(uint32_t i = 0; i < postOrder.size(); i++) loopObj.order[postOrder[i]] = postOrder.size() - 1 - i;
+  
+  loopObj.idom.assign(count, NO_BLOCK);
+  loopObj.idom[0] = 0;
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+    for(size_t i = postOrder.size() - 1; i-- > 0;)
+    {
+      uint32_t block = postOrder[i];
+      uint32_t idom = NO_BLOCK;
+      for(uint32_t pred : loopObj.preds[block])
+      {
+        if(loopObj.idom[pred] == NO_BLOCK) continue;
+        if(idom == NO_BLOCK)
+        {
+          idom = pred;
+          continue;
+        }
+        
+        //Walk both up the dominator tree until they meet
+        uint32_t other = pred;
+        while(idom != other)
+        {
+          while(loopObj.order[idom] > loopObj.order[other]) idom = loopObj.idom[idom];
+          while(loopObj.order[other] > loopObj.order[idom]) other = loopObj.idom[other];
+        }
+      }
+      if(loopObj.idom[block] != idom)
+      {
+        loopObj.idom[block] = idom;
+        changed = true;
+      }
+    }
+  }
+}
+
+/*
+ * Description: Puts a empty preheader right before every block a back edge goes to, a edge to a block that dominates
+ *              where it comes from. Every other edge to the header goes to the preheader instead, block 0 being a
+ *              header makes its preheader the new block 0.
+ * Passed:      The object of the program.
+ * Returns:     True if the program has any loop.
+ */
+static bool insertPreheaders(LoopObj& loopObj)
+{
+  IrProgram& program = loopObj.program;
+  size_t count = program.blocks.size();
+  uint32_t succs[2];
+  
+  std::vector<char> header(count, false);
+  bool found = false;
+  for(uint32_t i = 0; i < count; i++)
+  {
+    if(loopObj.idom[i] == NO_BLOCK) continue;
+    
+    uint32_t succCount = successors(program.blocks[i], succs);
+    for(uint32_t s = 0; s < succCount; s++)
+    {
+      if(dominates(loopObj, succs[s], i)) header[succs[s]] = found = true;
+    }
+  }
+  if(!found) return false;
+  
+  //New number of every block, a header's preheader is the number before it
+  std::vector<uint32_t> number(count);
+  uint32_t headers = 0;
+  for(uint32_t i = 0; i < count; i++)
+  {
+    if(header[i]) headers++;
+    number[i] = i + headers;
+  }
+  
+  std::vector<IrBlock> blocks;
+  blocks.reserve(count + headers);
+  for(uint32_t i = 0; i < count; i++)
+  {
+    if(header[i]) blocks.push_back({ {}, JUMP_tm, LE_rel, noArg(), noArg(), number[i], 0, 0 });
+    
+    IrBlock& block = program.blocks[i];
+    bool backTarget = block.term != STOP_tm && dominates(loopObj, block.target, i);
+    bool backOther = block.term == CBR_tm && dominates(loopObj, block.other, i);
+    if(block.term != STOP_tm) block.target = number[block.target] - (header[block.target] && !backTarget);
+    if(block.term == CBR_tm) block.other = number[block.other] - (header[block.other] && !backOther);
+    blocks.push_back(std::move(block));
+  }
+  program.blocks = std::move(blocks);
+  
+  return true;
+}
+
+/*
+ * Description: Finds every loop from the back edges to its header. The body is everything that reaches a latch
+ *              without going through the header. Loops are sorted smallest first so inner loops come first.
+ * Passed:      The object of the program.
+ */
+static void findLoops(LoopObj& loopObj)
+{
+  const IrProgram& PROGRAM = loopObj.program;
+  size_t count = PROGRAM.blocks.size();
+  uint32_t succs[2];
+  
+  std::vector<uint32_t> loopOf(count, NO_LOOP);
+  loopObj.loops.clear();
+  for(uint32_t i = 0; i < count; i++)
+  {
+    if(loopObj.idom[i] == NO_BLOCK) continue;
+    
+    uint32_t succCount = successors(PROGRAM.blocks[i], succs);
+    for(uint32_t s = 0; s < succCount; s++)
+    {
+      uint32_t header = succs[s];
+      if(!dominates(loopObj, header, i)) continue;
+      
+      if(loopOf[header] == NO_LOOP)
+      {
+        loopOf[header] = loopObj.loops.size();
+        loopObj.loops.push_back({ header, header - 1 });
+      }
+      std::vector<uint32_t>& latches = loopObj.loops[loopOf[header]].latches;
+      if(latches.empty() || latches.back() != i) latches.push_back(i);
+    }
+  }
+  
+  std::vector<char> inBody(count, false);
+  for(Loop& loop : loopObj.loops)
+  {
+    std::vector<uint32_t> stack(loop.latches);
+    loop.body.push_back(loop.header);
+    inBody[loop.header] = true;
+    for(uint32_t latch : loop.latches)
+    {
+      if(inBody[latch]) continue;
+      inBody[latch] = true;
+      loop.body.push_back(latch);
+    }
+    while(!stack.empty())
+    {
+      uint32_t block = stack.back();
+      stack.pop_back();
+      if(block == loop.header) continue;
+      
+      for(uint32_t pred : loopObj.preds[block])
+      {
+        if(inBody[pred] || loopObj.idom[pred] == NO_BLOCK) continue;
+        inBody[pred] = true;
+        loop.body.push_back(pred);
+        stack.push_back(pred);
+      }
+    }
+    
+    for(uint32_t block : loop.body) inBody[block] = false;
+    std::sort(loop.body.begin(), loop.body.end());
+  }
+  
+  std::stable_sort(loopObj.loops.begin(), loopObj.loops.end(),
+                   [](const Loop& A, const Loop& B) { return A.body.size() < B.body.size(); });
+}
+
+/*
+ * Description: Moves every instruction of LOOP whose arguments the loop does not change to the end of its preheader
+ *              in the order they are found. A variable set that way keeps a copy of a _h(num) set in the preheader
+ *              instead, unless it is a variable of this pass which is only set there. Temps moved out that the loop
+ *              still uses are replaced by _h(num) variables since temps do not live across blocks.
+ * Passed:      The object of the program and the loop.
+ */
+static void hoistInvariants(LoopObj& loopObj, const Loop& LOOP)
+{
+  IrProgram& program = loopObj.program;
+  IrBlock& preheader = program.blocks[LOOP.preheader];
+  size_t firstHoisted = preheader.instrs.size();
+  std::vector<char> invariant(program.temps, false);
+  
+  markDefined(loopObj, LOOP);
+  for(uint32_t b : LOOP.body)
+  {
+    IrBlock& block = program.blocks[b];
+    size_t kept = 0;
+    for(size_t i = 0; i < block.instrs.size(); i++)
+    {
+      IrInstr instr = block.instrs[i];
+      if(isInvariant(loopObj, instr, invariant))
+      {
+        loopObj.report.hoisted++;
+        if(instr.dest.kind == TEMP_ia || loopObj.hoistVar[instr.dest.id])
+        {
+          if(instr.dest.kind == TEMP_ia) invariant[instr.dest.id] = true;
+          else loopObj.defined[instr.dest.id] = false;
+          preheader.instrs.push_back(instr);
+          continue;
+        }
+        
+        //The variable is still set every iteration, only the work is moved
+        uint32_t var = newVar(loopObj, 'h', true);
+        preheader.instrs.push_back({ instr.op, symbolArg(var), instr.a, instr.b, instr.line });
+        instr = { COPY_ir, instr.dest, symbolArg(var), noArg(), instr.line };
+      }
+      block.instrs[kept++] = instr;
+    }
+    block.instrs.resize(kept);
+  }
+  
+  //Temps moved out that the loop still uses need a variable
+  std::vector<uint32_t> vars(program.temps, NO_VAR);
+  bool renamed = false;
+  for(uint32_t b : LOOP.body)
+  {
+    IrBlock& block = program.blocks[b];
+    IrArg* args[2] = { &block.a, &block.b };
+    for(IrInstr& instr : block.instrs)
+    {
+      args[0] = &instr.a;
+      args[1] = &instr.b;
+      for(IrArg* arg : args)
+      {
+        if(arg->kind != TEMP_ia || !invariant[arg->id]) continue;
+        if(vars[arg->id] == NO_VAR) vars[arg->id] = newVar(loopObj, 'h', true);
+        renamed = true;
+      }
+    }
+    if(block.term != CBR_tm) continue;
+    
+    args[0] = &block.a;
+    args[1] = &block.b;
+    for(IrArg* arg : args)
+    {
+      if(arg->kind != TEMP_ia || !invariant[arg->id]) continue;
+      if(vars[arg->id] == NO_VAR) vars[arg->id] = newVar(loopObj, 'h', true);
+      renamed = true;
+    }
+  }
+  if(!renamed) return;
+  
+  for(size_t i = firstHoisted; i < preheader.instrs.size(); i++)
+  {
+    renameTemp(preheader.instrs[i].dest, vars);
+    renameTemp(preheader.instrs[i].a, vars);
+    renameTemp(preheader.instrs[i].b, vars);
+  }
+  for(uint32_t b : LOOP.body)
+  {
+    IrBlock& block = program.blocks[b];
+    for(IrInstr& instr : block.instrs)
+    {
+      renameTemp(instr.a, vars);
+      renameTemp(instr.b, vars);
+    }
+    if(block.term != CBR_tm) continue;
+    renameTemp(block.a, vars);
+    renameTemp(block.b, vars);
+  }
+}
+
+/*
+ * Description: Reduces the multiplications of every induction variable of LOOP by something the loop does not change,
+ *              i * k. The induction variable has to be set once in the loop by adding or subtracting a integer c in
+ *              a block that runs once every iteration. The preheader sets a _s(num) to i * k which gets c * k added
+ *              right after i changes, and every i * k of the loop becomes a copy of the _s(num).
+ *              Each multiplication replaced saves the target one instruction and the add costs ADD_COST, so a pair
+ *              used ADD_COST times or less is counted as unprofitable and left.
+ * Passed:      The object of the program and the number of the loop.
+ */
+static void reduceStrength(LoopObj& loopObj, const uint32_t LOOP)
+{
+  IrProgram& program = loopObj.program;
+  const Loop& loop = loopObj.loops[LOOP];
+  markDefined(loopObj, loop);
+  
+  //How many times the loop sets every symbol
+  std::vector<uint32_t> sets(loopObj.defined.size(), 0);
+  for(uint32_t b : loop.body)
+  {
+    for(const IrInstr& instr : program.blocks[b].instrs)
+    {
+      if(instr.dest.kind == SYMBOL_ia) sets[instr.dest.id]++;
+    }
+  }
+  
+  const std::vector<char> NOTEMPS;
+  for(uint32_t b : loop.body)
+  {
+    if(loopObj.innermost[b] != LOOP) continue;
+    
+    //The block has to run every iteration
+    bool everyIteration = true;
+    for(uint32_t latch : loop.latches) everyIteration &= dominates(loopObj, b, latch);
+    if(!everyIteration) continue;
+    
+    for(size_t i = 0; i < program.blocks[b].instrs.size(); i++)
+    {
+      const IrInstr STEP = program.blocks[b].instrs[i];
+      if(STEP.dest.kind != SYMBOL_ia || STEP.dest.id >= sets.size() || sets[STEP.dest.id] != 1) continue;
+      
+      IrArg induction = STEP.dest;
+      uint32_t step;
+      if((STEP.op == ADD_ir || STEP.op == SUB_ir) && STEP.a == induction && STEP.b.kind == INT_ia)
+      {
+        step = STEP.op == ADD_ir ? STEP.b.id : 0u - STEP.b.id;
+      }
+      else if(STEP.op == ADD_ir && STEP.b == induction && STEP.a.kind == INT_ia)
+      {
+        step = STEP.a.id;
+      }
+      else continue;
+      
+      //How many times every k is multiplied by the induction variable
+      std::vector<std::pair<IrArg, uint32_t>> factors;
+      for(uint32_t u : loop.body)
+      {
+        for(const IrInstr& instr : program.blocks[u].instrs)
+        {
+          if(instr.op != MULT_ir) continue;
+          
+          IrArg factor;
+          if(instr.a == induction && isInvariantArg(loopObj, instr.b, NOTEMPS)) factor = instr.b;
+          else if(instr.b == induction && isInvariantArg(loopObj, instr.a, NOTEMPS)) factor = instr.a;
+          else continue;
+          
+          size_t f = 0;
+          while(f < factors.size() && factors[f].first != factor) f++;
+          if(f == factors.size()) factors.push_back({ factor, 0 });
+          factors[f].second++;
+        }
+      }
+      
+      for(const std::pair<IrArg, uint32_t>& FACTOR : factors)
+      {
+        if(FACTOR.second <= ADD_COST)
+        {
+          loopObj.report.unprofitable += FACTOR.second;
+          continue;
+        }
+        
+        //What the new variable goes up by, c * k wrapping like the target
+        const IrArg K = FACTOR.first;
+        std::vector<IrInstr>& preheader = program.blocks[loop.preheader].instrs;
+        IrArg increment;
+        if(K.kind == INT_ia) increment = intArg(static_cast<int32_t>(K.id * step));
+        else if(step == 1) increment = K;
+        else
+        {
+          increment = symbolArg(newVar(loopObj, 's', true));
+          preheader.push_back({ MULT_ir, increment, K, intArg(static_cast<int32_t>(step)), STEP.line });
+        }
+        IrArg reduced = symbolArg(newVar(loopObj, 's', false));
+        preheader.push_back({ MULT_ir, reduced, induction, K, STEP.line });
+        
+        for(uint32_t u : loop.body)
+        {
+          for(IrInstr& instr : program.blocks[u].instrs)
+          {
+            if(instr.op != MULT_ir) continue;
+            if((instr.a == induction && instr.b == K) || (instr.b == induction && instr.a == K))
+            {
+              instr = { COPY_ir, instr.dest, reduced, noArg(), instr.line };
+              loopObj.report.reduced++;
+            }
+          }
+        }
+        std::vector<IrInstr>& instrs = program.blocks[b].instrs;
+        instrs.insert(instrs.begin() + ++i, { ADD_ir, reduced, reduced, increment, STEP.line });
+      }
+    }
+  }
+}
+
+/*
+ * Description: Checks if INSTR works out the same value every iteration of the loop being optimized and can not fault.
+ *              Reading, writing and copying into a variable that is not one of this pass are never moved.
+ * Passed:      The object of the program, the instruction and which temps have been hoisted.
+ * Returns:     True if the instruction can be hoisted.
+ */
+static bool isInvariant(const LoopObj& LOOPOBJ, const IrInstr& INSTR, const std::vector<char>& INVARIANT)
+{
+  if(INSTR.op == READ_ir || INSTR.op == WRITE_ir) return false;
+  if(INSTR.op == DIV_ir && (INSTR.b.kind != INT_ia || INSTR.b.id == 0 || INSTR.b.id == static_cast<uint32_t>(-1))) return false;
+  if(INSTR.dest.kind == SYMBOL_ia && INSTR.op == COPY_ir && !LOOPOBJ.hoistVar[INSTR.dest.id]) return false;
+  
+  return isInvariantArg(LOOPOBJ, INSTR.a, INVARIANT) && isInvariantArg(LOOPOBJ, INSTR.b, INVARIANT);
+}
+
+//Checks if ARG is the same every iteration, a integer, a symbol the loop does not set or a hoisted temp
+static bool isInvariantArg(const LoopObj& LOOPOBJ, const IrArg& ARG, const std::vector<char>& INVARIANT)
+{
+  if(ARG.kind == SYMBOL_ia) return !LOOPOBJ.defined[ARG.id];
+  if(ARG.kind == TEMP_ia) return ARG.id < INVARIANT.size() && INVARIANT[ARG.id];
+  
+  return true;
+}
+
+//Marks every symbol LOOP sets in loopObj.defined and clears the rest
+static void markDefined(LoopObj& loopObj, const Loop& LOOP)
+{
+  loopObj.defined.assign(loopObj.table.symbolTable().size(), false);
+  loopObj.hoistVar.resize(loopObj.defined.size(), false);
+  for(uint32_t b : LOOP.body)
+  {
+    for(const IrInstr& instr : loopObj.program.blocks[b].instrs)
+    {
+      if(instr.dest.kind == SYMBOL_ia) loopObj.defined[instr.dest.id] = true;
+    }
+  }
+}
+
+//Replaces arg with the variable of its temp in VARS if it has one
+static void renameTemp(IrArg& arg, const std::vector<uint32_t>& VARS)
+{
+  if(arg.kind == TEMP_ia && VARS[arg.id] != NO_VAR) arg = symbolArg(VARS[arg.id]);
+}
+
+/*
+ * Description: Makes the variable _(PREFIX)(num) and adds it to the semantic table.
+ * Passed:      The object of the program, the letter the name starts with and if it is only set in a preheader.
+ * Returns:     The symbol ID of the variable.
+ */
+static uint32_t newVar(LoopObj& loopObj, const char PREFIX, const bool SETONCE)
+{
+  std::string name = "_";
+  name += PREFIX;
+  name += std::to_string(loopObj.vars++);
+  
+  uint32_t symbol = loopObj.table.symbolTable().intern(name);
+  loopObj.table.insert(symbol, -1);
+  if(symbol >= loopObj.defined.size()) loopObj.defined.resize(symbol + 1, false);
+  if(symbol >= loopObj.hoistVar.size()) loopObj.hoistVar.resize(symbol + 1, false);
+  loopObj.hoistVar[symbol] = SETONCE;
+  
+  return symbol;
+}
+
+/*
+ * Checks if every path from block 0 to block goes through DOMINATOR. A dominator comes before the blocks it
+ * dominates in reverse post order so the walk up the dominator tree stops once it is past DOMINATOR, a edge
+ * going forward is answered without walking at all.
+ */
+static bool dominates(const LoopObj& LOOPOBJ, const uint32_t DOMINATOR, uint32_t block)
+{
+  if(LOOPOBJ.idom[block] == NO_BLOCK) return false;
+  while(LOOPOBJ.order[block] > LOOPOBJ.order[DOMINATOR]) block = LOOPOBJ.idom[block];
+  
+  return block == DOMINATOR;
+}
+
+//Saves the blocks BLOCK can go to into succs and returns how many there are
+static uint32_t successors(const IrBlock& BLOCK, uint32_t succs[2])
+{
+  if(BLOCK.term == STOP_tm) return 0;
+  succs[0] = BLOCK.target;
+  if(BLOCK.term == JUMP_tm || BLOCK.other == BLOCK.target) return 1;
+  succs[1] = BLOCK.other;
+  return 2;
+}
\ No newline at end of file
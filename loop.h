@@ -0,0 +1,37 @@
+#ifndef LOOP_H
+#define LOOP_H
+
+#include <cstdint>
+#include <ostream>
+
+#include "ir.h"
+#include "statSem.h"
+
+//What optimizeLoops did
+struct LoopReport {
+  uint32_t loops = 0;        //Loops found
+  uint32_t hoisted = 0;      //Instructions moved out of a loop into the block before it
+  uint32_t reduced = 0;      //Multiplications by a induction variable replaced by a variable kept up to date by adding
+  uint32_t unprofitable = 0; //Multiplications that could be reduced but were left since the adding costs more
+};
+
+/*
+ * Description: Optimizes every loop of PROGRAM, inner loops first. A loop is a header block and the blocks that go back
+ *              to it that the header dominates. Every loop gets a preheader, a block laid out right before its header
+ *              that everything outside the loop goes to the header through.
+ *              - instructions whose arguments do not change in the loop are hoisted into the preheader. This takes
+ *                the right side of the test of a iterate too. A division that could fault is left where it is.
+ *              - a multiplication of a induction variable, one the loop only adds a integer to once per iteration,
+ *                by something the loop does not change becomes a copy of a variable set in the preheader and added to
+ *                after the induction variable is. This is only done when the accumulator target saves more than the
+ *                add costs, which takes more than 3 such multiplications of the same pair.
+ *              Values that now live across blocks are kept in _h(num) and _s(num) variables which are added to the
+ *              semantic table. Empty preheaders are left for simplifyCfg (cfg.h) to remove.
+ * Passed:      The program, its semantic table and the report to count what was done in.
+ */
+void optimizeLoops(IrProgram& program, SemanticTable& table, LoopReport& report);
+
+//Prints how many loops optimizeLoops found and what it did to out
+void printReport(const LoopReport& REPORT, std::ostream& out);
+
+#endif
\ No newline at end of file
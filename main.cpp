@@ -5,36 +5,83 @@
 #include <stdexcept>
 
 #include "compiler.h"
+#include "batch.h"
+#include "parser.h"
 
 static void exitError(const std::string S);
-static void readInput(std::string tempFileName, std::string inputFileName);
+static uint32_t parseRules(const std::string LIST);
+static void parseEmit(const std::string LIST, CompileOptions& options);
+static ScannerBackend parseScanner(const std::string NAME);
+static ParserBackend parseParser(const std::string NAME);
+static size_t parseCount(const std::string TEXT);
 
 
 int main(int argc, char *argv[]) 
 {
-  const std::string TEMPFILENAME = "temp.txt";
+  //Options come before the program or --batch
+  CompileOptions options;
+  int arg = 1;
+  for(; arg < argc && std::string(argv[arg]) != "--batch" && std::string(argv[arg]).rfind("--", 0) == 0; arg++)
+  {
+    std::string option = argv[arg];
+    if(option == "--opt-report") options.optReport = true;
+    else if(option == "--emit-ir") options.emitIr = true;
+    else if(option == "--no-fold") options.fold = false;
+    else if(option.rfind("--emit=", 0) == 0) parseEmit(option.substr(7), options);
+    else if(option.rfind("--peephole=", 0) == 0) options.peepholeRules = parseRules(option.substr(11));
+    else if(option.rfind("--scanner=", 0) == 0) options.scanner = parseScanner(option.substr(10));
+    else if(option.rfind("--parser=", 0) == 0) options.parser = parseParser(option.substr(9));
+    else if(option.rfind("--lex-threads=", 0) == 0) options.lexThreads = parseCount(option.substr(14));
+    else if(option == "--pipeline") options.pipeline = true;
+    else exitError("Unknown option " + option);
+  }
+  //A program scanned up front in chunks has no scanner left to run on a thread of its own
+  if(options.pipeline && options.lexThreads != 1) exitError("--pipeline needs --lex-threads=1");
+  
+  //Batch mode compiles a directory or list of programs at once (batch.h)
+  if(arg < argc && std::string(argv[arg]) == "--batch")
+  {
+    if(argc != arg + 2) exitError("Usage: compile [options] --batch <directory|list file>");
+    
+    bool success = false;
+    try
+    {
+      success = compileBatch(argv[arg + 1], std::cout, options);
+    }
+    catch(const std::invalid_argument &e) //Directory or list could not be read
+    {
+      exitError(e.what());
+    }
+    return success ? 0 : 1;
+  }
   
   //Program is only passed one argument
-  if(argc > 2) exitError("Too many arguments");
+  if(argc > arg + 1) exitError("Too many arguments");
   
-  bool error;
+  bool error = false;
   //Reading for stdin
-  if(argc == 1) 
+  if(argc == arg) 
   {
-    readInput(TEMPFILENAME, "");
-    error = compile(TEMPFILENAME, "");
+    error = compile("", "", std::cout, options);
   } 
   //Reading from a file
   else
   {
-    readInput(TEMPFILENAME, argv[1]);
-    error = compile(TEMPFILENAME, argv[1]);
+    std::string inputFileName = argv[arg];
+    inputFileName += ".4280fs24";
+    
+    try
+    {
+      error = compile(inputFileName, argv[arg], std::cout, options);
+    }
+    catch(const std::invalid_argument &e) //Input file could not be opened
+    {
+      exitError("File does not exist! File must end with extension .4280fs24!");
+    }
   }
 
   std::string printText = error ?  "Compilation Success" : "Compilation Failure";
   std::cout << printText << std::endl;
-  
-  remove(TEMPFILENAME.c_str());
 
   return 0;
 }
@@ -51,40 +98,98 @@ static void exitError(const std::string S)
   exit(1);
 }
 
-
 /*
- *  Desription: Reads input from either stdin or a file saves read in input to temp.txt
- *  Passed: It is passed either a filename to print to and a file name to read from. "" for stdin.
- *  Return: Returns nothing
+ *  Description: Reads the peephole rules to run from --peephole=LIST. LIST is all, none or rule names split by commas,
+ *               the names are the ones printed by --opt-report (peephole.h). Exits on a name that is not a rule.
+ *  Passed: The LIST of rules.
+ *  Return: The rules as bits, 1 << rule for each rule.
  */
-static void readInput(std::string tempFileName, std::string inputFileName)
+static uint32_t parseRules(const std::string LIST)
 {
-  std::ofstream fileOut; 
-  fileOut.open(tempFileName.c_str());
-  if (!fileOut.is_open()) exitError("Failed to open temp file!");
-  
-  std::string input;
+  if(LIST == "all") return ALL_PEEPHOLE;
+  if(LIST == "none") return 0;
   
-  if(inputFileName.empty()) //Read from stdin 
+  uint32_t rules = 0;
+  size_t start = 0;
+  while(start <= LIST.size())
   {
-    while(std::getline(std::cin, input))
-    {
-      fileOut << input << std::endl;
-    }
-  } 
-  else //Read from File
-  {
-    std::ifstream in;
-    inputFileName += ".4280fs24";
+    size_t end = LIST.find(',', start);
+    if(end == std::string::npos) end = LIST.size();
     
-    in.open(inputFileName.c_str());
-    if(in.fail()) exitError("File does not exist! File must end with extension .4280fs24!");
+    PeepholeRule rule;
+    std::string name = LIST.substr(start, end - start);
+    if(!findPeepholeRule(name, rule)) exitError("Unknown peephole rule " + name);
+    rules |= 1u << rule;
+    start = end + 1;
+  }
+  
+  return rules;
+}
+
+/*
+ *  Description: Reads what to save from --emit=LIST. LIST is asm, bin and ir split by commas, asm is the text target,
+ *               bin the binary object (object.h) and ir the three address code. Exits on anything else.
+ *  Passed: The LIST of outputs and the options to set them in.
+ */
+static void parseEmit(const std::string LIST, CompileOptions& options)
+{
+  options.emitAsm = false;
+  size_t start = 0;
+  while(start <= LIST.size())
+  {
+    size_t end = LIST.find(',', start);
+    if(end == std::string::npos) end = LIST.size();
     
-    while(std::getline(in, input))
-    {
-      fileOut << input << std::endl;
-    }
-    in.close();
+    std::string name = LIST.substr(start, end - start);
+    if(name == "asm") options.emitAsm = true;
+    else if(name == "bin") options.emitBin = true;
+    else if(name == "ir") options.emitIr = true;
+    else exitError("Unknown output " + name);
+    start = end + 1;
   }
-  fileOut.close();
 }
+
+/*
+ *  Description: Reads which scanner builds the tokens from --scanner=NAME, NAME is table or direct (scanner.h).
+ *               Exits on anything else.
+ *  Passed: The NAME of the scanner.
+ *  Return: The scanner backend.
+ */
+static ScannerBackend parseScanner(const std::string NAME)
+{
+  for(int backend = 0; backend < SCANNERS; backend++)
+    if(NAME == SCANNER_NAMES[backend]) return static_cast<ScannerBackend>(backend);
+  
+  exitError("Unknown scanner " + NAME);
+  return DIRECT_scan;
+}
+
+/*
+ *  Description: Reads which parser builds the tree from --parser=NAME, NAME is descent or table (parser.h).
+ *               Exits on anything else.
+ *  Passed: The NAME of the parser.
+ *  Return: The parser backend.
+ */
+static ParserBackend parseParser(const std::string NAME)
+{
+  for(int backend = 0; backend < PARSERS; backend++)
+    if(NAME == PARSER_NAMES[backend]) return static_cast<ParserBackend>(backend);
+  
+  exitError("Unknown parser " + NAME);
+  return DESCENT_parse;
+}
+
+/*
+ *  Description: Reads a count like the N of --lex-threads=N. Exits if TEXT is not a number.
+ *  Passed: The TEXT of the count.
+ *  Return: The count.
+ */
+static size_t parseCount(const std::string TEXT)
+{
+  size_t count = 0;
+  if(TEXT.empty() || TEXT.size() > 6 || TEXT.find_first_not_of("0123456789") != std::string::npos)
+    exitError("Bad count " + TEXT);
+  for(char digit : TEXT) count = count * 10 + (digit - '0');
+  
+  return count;
+}
\ No newline at end of file
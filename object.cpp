@@ -0,0 +1,197 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "object.h"
+
+const size_t HEADER_WORDS = 8; //Magic, version, five counts and the flags word
+
+static void putWord(std::string& out, const uint32_t WORD);
+static uint32_t getWord(const char* DATA, const size_t WORD);
+static uint32_t addName(std::string& names, const std::string& NAME);
+static std::string getName(const char* NAMES, const uint32_t SIZE, const uint32_t OFFSET);
+static void objectError(const std::string MESSAGE);
+
+//Checks if the SIZE bytes at DATA start like an object
+bool isObject(const char* DATA, const size_t SIZE)
+{
+  return SIZE >= sizeof(OBJECT_MAGIC) && std::memcmp(DATA, OBJECT_MAGIC, sizeof(OBJECT_MAGIC)) == 0;
+}
+
+/*
+ * Description: Appends the object of PROGRAM to out.
+ *              Throws a invalid_argument error if a argument is bigger than OBJECT_MAX_ARG.
+ * Passed:      The decoded program and the string to append the object to.
+ */
+void writeObject(const Program& PROGRAM, std::string& out)
+{
+  //Every name goes into one section, the symbols and labels point into it
+  std::string names;
+  std::vector<uint32_t> nameOffsets;
+  std::vector<uint32_t> labelOffsets;
+  for(const std::string& name : PROGRAM.names) nameOffsets.push_back(addName(names, name));
+  for(const std::pair<uint32_t, std::string>& label : PROGRAM.labels) labelOffsets.push_back(addName(names, label.second));
+  names.resize((names.size() + 3) & ~static_cast<size_t>(3), '\0');
+  
+  uint32_t codeCount = PROGRAM.code.size() - 1; //The STOP the loader added is left out
+  out.append(OBJECT_MAGIC, sizeof(OBJECT_MAGIC));
+  putWord(out, OBJECT_VERSION);
+  putWord(out, codeCount);
+  putWord(out, PROGRAM.memory.size());
+  putWord(out, PROGRAM.names.size());
+  putWord(out, PROGRAM.labels.size());
+  putWord(out, names.size());
+  putWord(out, 0);
+  
+  for(uint32_t i = 0; i < codeCount; i++)
+  {
+    if(PROGRAM.code[i].arg > OBJECT_MAX_ARG) objectError("argument too big at instruction " + std::to_string(i));
+    putWord(out, static_cast<uint32_t>(PROGRAM.code[i].op) << (32 - OBJECT_OP_BITS) | PROGRAM.code[i].arg);
+  }
+  for(uint32_t i = 0; i < codeCount; i++)
+    putWord(out, static_cast<uint32_t>(i < PROGRAM.lines.size() ? PROGRAM.lines[i] : 0)); //None for text programs
+  for(int32_t value : PROGRAM.memory) putWord(out, static_cast<uint32_t>(value));
+  for(uint32_t offset : nameOffsets) putWord(out, offset);
+  for(size_t i = 0; i < PROGRAM.labels.size(); i++)
+  {
+    putWord(out, PROGRAM.labels[i].first);
+    putWord(out, labelOffsets[i]);
+  }
+  out += names;
+}
+
+/*
+ * Description: Decodes the object in the SIZE bytes at DATA. Every count is checked against the size, every opcode,
+ *              branch and memory cell against the program and every name against the names section.
+ *              Throws a invalid_argument error if the object is malformed or of another version.
+ * Passed:      The bytes of the object and how many there are
+ * Returns:     The decoded program, ending in STOP like the text loader leaves it
+ */
+Program loadObject(const char* DATA, const size_t SIZE)
+{
+  if(!isObject(DATA, SIZE) || SIZE < HEADER_WORDS * 4) objectError("not an object");
+  if(getWord(DATA, 1) != OBJECT_VERSION) objectError("unsupported version " + std::to_string(getWord(DATA, 1)));
+  
+  uint32_t codeCount = getWord(DATA, 2);
+  uint32_t memoryCount = getWord(DATA, 3);
+  uint32_t variableCount = getWord(DATA, 4);
+  uint32_t labelCount = getWord(DATA, 5);
+  uint32_t nameBytes = getWord(DATA, 6);
+  
+  //Counts are added as 64-bit so a bad one can not wrap around past the size check
+  uint64_t words = HEADER_WORDS + 2ull * codeCount + memoryCount + variableCount + 2ull * labelCount;
+  if(variableCount > memoryCount || nameBytes % 4 != 0 || words * 4 + nameBytes != SIZE) objectError("bad section sizes");
+  
+  Program program;
+  size_t word = HEADER_WORDS;
+  program.code.reserve(codeCount + 1);
+  for(uint32_t i = 0; i < codeCount; i++, word++)
+  {
+    uint32_t op = getWord(DATA, word) >> (32 - OBJECT_OP_BITS);
+    uint32_t arg = getWord(DATA, word) & OBJECT_MAX_ARG;
+    if(op >= OPCODES) objectError("bad opcode at instruction " + std::to_string(i));
+    
+    Operand operand = OPCODE_OPERANDS[op];
+    if((operand == LABEL_arg && arg > codeCount) || (operand == VALUE_arg && arg >= memoryCount) ||
+       (operand == VARIABLE_arg && arg >= variableCount))
+      objectError("bad argument at instruction " + std::to_string(i));
+    
+    program.code.push_back({ static_cast<Opcode>(op), operand == NONE_arg ? 0 : arg });
+  }
+  program.code.push_back({ STOP_op, 0 }); //Running off the end stops the program
+  
+  program.lines.resize(codeCount);
+  for(uint32_t i = 0; i < codeCount; i++, word++) program.lines[i] = static_cast<int32_t>(getWord(DATA, word));
+  
+  program.memory.resize(memoryCount);
+  for(uint32_t i = 0; i < memoryCount; i++, word++) program.memory[i] = static_cast<int32_t>(getWord(DATA, word));
+  
+  const char* names = DATA + (words * 4);
+  for(uint32_t i = 0; i < variableCount; i++, word++)
+    program.names.push_back(getName(names, nameBytes, getWord(DATA, word)));
+  for(uint32_t i = 0; i < labelCount; i++, word += 2)
+  {
+    uint32_t index = getWord(DATA, word);
+    if(index > codeCount) objectError("bad label " + std::to_string(i));
+    program.labels.emplace_back(index, getName(names, nameBytes, getWord(DATA, word + 1)));
+  }
+  
+  return program;
+}
+
+/*
+ * Description: Prints PROGRAM back as target text the way the compiler writes it: labels as name: before their
+ *              instruction, integer operands as their value and every variable with its starting value at the end.
+ *              The target text has no place for the source lines so they are left out.
+ * Passed:      The decoded program and the stream to print to.
+ */
+void disassemble(const Program& PROGRAM, std::ostream& out)
+{
+  //Labels on every instruction, and the first one a branch to it is written with
+  std::vector<std::vector<const std::string*>> labelsAt(PROGRAM.code.size());
+  for(const std::pair<uint32_t, std::string>& label : PROGRAM.labels) labelsAt[label.first].push_back(&label.second);
+  
+  for(size_t i = 0; i + 1 < PROGRAM.code.size(); i++)
+  {
+    //Only one label fits before a instruction, any others get a line of their own
+    const std::vector<const std::string*>& labels = labelsAt[i];
+    for(size_t l = 1; l < labels.size(); l++) out << *labels[l] << ":\n";
+    if(!labels.empty()) out << *labels[0] << ": ";
+    
+    const Instruction& instruction = PROGRAM.code[i];
+    Operand operand = OPCODE_OPERANDS[instruction.op];
+    out << OPCODE_NAMES[instruction.op];
+    if(operand == LABEL_arg)
+    {
+      if(labelsAt[instruction.arg].empty()) out << " L" << instruction.arg; //Only a hand made object has no label there
+      else out << " " << *labelsAt[instruction.arg][0];
+    }
+    else if(operand != NONE_arg && instruction.arg < PROGRAM.names.size()) out << " " << PROGRAM.names[instruction.arg];
+    else if(operand != NONE_arg) out << " " << PROGRAM.memory[instruction.arg];
+    out << '\n';
+  }
+  
+  //Labels past the last instruction are on the STOP the loader adds
+  for(const std::string* label : labelsAt.back()) out << *label << ":\n";
+  
+  for(size_t i = 0; i < PROGRAM.names.size(); i++) out << PROGRAM.names[i] << " " << PROGRAM.memory[i] << '\n';
+}
+
+//Appends WORD to out as 4 little endian bytes
+static void putWord(std::string& out, const uint32_t WORD)
+{
+  char bytes[4] = { static_cast<char>(WORD), static_cast<char>(WORD >> 8), static_cast<char>(WORD >> 16),
+                    static_cast<char>(WORD >> 24) };
+  out.append(bytes, 4);
+}
+
+//Returns the little endian word number WORD of DATA
+static uint32_t getWord(const char* DATA, const size_t WORD)
+{
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(DATA) + WORD * 4;
+  return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+//Appends NAME and its 0 byte to names and returns where it starts
+static uint32_t addName(std::string& names, const std::string& NAME)
+{
+  uint32_t offset = names.size();
+  names += NAME;
+  names += '\0';
+  return offset;
+}
+
+//Returns the name at OFFSET of the SIZE bytes of NAMES, it has to end with a 0 byte inside them
+static std::string getName(const char* NAMES, const uint32_t SIZE, const uint32_t OFFSET)
+{
+  if(OFFSET >= SIZE) objectError("bad name offset");
+  
+  const void* end = std::memchr(NAMES + OFFSET, '\0', SIZE - OFFSET);
+  if(end == nullptr) objectError("unterminated name");
+  return std::string(NAMES + OFFSET, static_cast<const char*>(end) - (NAMES + OFFSET));
+}
+
+//Throws a invalid_argument error for a malformed object
+static void objectError(const std::string MESSAGE)
+{
+  throw std::invalid_argument("Error: Bad object file, " + MESSAGE);
+}
\ No newline at end of file
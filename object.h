@@ -0,0 +1,65 @@
+//Target language information can be found here https://comp.umsl.edu/assembler/index
+
+#ifndef OBJECT_H
+#define OBJECT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "vm.h"
+
+/*
+ * Binary object format of a target program. It holds the decoded Program (vm.h) so a loader only has to check it,
+ * not tokenise it and look labels and variables up. Every field is a little endian 32-bit word and every section
+ * starts 4-byte aligned so the file can be mapped and read in place. In order the file holds:
+ *
+ *   header  OBJECT_MAGIC, OBJECT_VERSION, then how many code entries, memory cells, variables, labels and bytes of
+ *           names there are, then a word of 0 reserved for flags
+ *   code    one word for every instruction, the opcode in the top OBJECT_OP_BITS and the argument in the rest.
+ *           Arguments are memory cells, branches hold the index of the instruction they go to. The STOP the loader
+ *           adds after the last instruction is not stored
+ *   lines   the line of the source program every instruction was made for, 0 if it is not known, for the errors
+ *           the interpreter stops a program with
+ *   memory  starting value of every cell, the variables first then one cell for every integer operand
+ *   symbols offset of the name of every variable in names
+ *   labels  index of the instruction every label is on and the offset of its name, in the order they were defined
+ *   names   every name followed by a 0 byte, padded with 0 to 4 bytes
+ */
+
+const char OBJECT_MAGIC[4] = { 'A', 'S', 'M', 'B' }; //First 4 bytes of every object
+const uint32_t OBJECT_VERSION = 1;                   //Layout above, a loader refuses any other version
+const uint32_t OBJECT_OP_BITS = 4;                   //Bits of a code word holding the opcode
+const uint32_t OBJECT_MAX_ARG = (1u << (32 - OBJECT_OP_BITS)) - 1; //Largest argument a code word can hold
+
+static_assert(OPCODES <= 1u << OBJECT_OP_BITS, "every opcode has to fit in a code word");
+
+//Checks if the SIZE bytes at DATA start like an object
+bool isObject(const char* DATA, const size_t SIZE);
+
+/*
+ * Description: Appends the object of PROGRAM to out.
+ *              Throws a invalid_argument error if a argument is bigger than OBJECT_MAX_ARG.
+ * Passed:      The decoded program and the string to append the object to.
+ */
+void writeObject(const Program& PROGRAM, std::string& out);
+
+/*
+ * Description: Decodes the object in the SIZE bytes at DATA. Every count is checked against the size, every opcode,
+ *              branch and memory cell against the program and every name against the names section.
+ *              Throws a invalid_argument error if the object is malformed or of another version.
+ * Passed:      The bytes of the object and how many there are
+ * Returns:     The decoded program, ending in STOP like the text loader leaves it
+ */
+Program loadObject(const char* DATA, const size_t SIZE);
+
+/*
+ * Description: Prints PROGRAM back as target text the way the compiler writes it: labels as name: before their
+ *              instruction, integer operands as their value and every variable with its starting value at the end.
+ *              The target text has no place for the source lines so they are left out.
+ * Passed:      The decoded program and the stream to print to.
+ */
+void disassemble(const Program& PROGRAM, std::ostream& out);
+
+#endif
\ No newline at end of file
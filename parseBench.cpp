@@ -0,0 +1,88 @@
+//Parses a program once with a parser backend (parser.h) and reports how many nodes the tree (tree.h) has, the peak
+//resident memory and how long the parse took, then how long checking its static semantics (statSem.h) took. Run by
+//make parse-bench and make sem-bench on programs from proggen
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/resource.h>
+
+#include "source.h"
+#include "scanner.h"
+#include "symbols.h"
+#include "parser.h"
+#include "tree.h"
+#include "statSem.h"
+
+static long peakKilobytes();
+static void exitError(const std::string S);
+
+
+int main(int argc, char *argv[]) 
+{
+  if(argc != 3) exitError("Usage: parsebench descent|table file.4280fs24");
+  
+  ParserBackend backend = PARSERS;
+  for(int i = 0; i < PARSERS; i++)
+    if(std::string(argv[1]) == PARSER_NAMES[i]) backend = static_cast<ParserBackend>(i);
+  if(backend == PARSERS) exitError(std::string("Unknown parser ") + argv[1]);
+  
+  std::string program;
+  try
+  {
+    SourceBuffer source(argv[2]);
+    program.assign(source.begin(), source.end() - source.begin());
+  }
+  catch(const std::invalid_argument &e) //Program file could not be opened
+  {
+    exitError(std::string("File does not exist! ") + argv[2]);
+  }
+  if(!program.empty() && program.back() != '\n') program += '\n'; //Like compileBuffer
+  
+  //The program is loaded before the peak is first read so only what the parse takes on top of it is counted
+  long before = peakKilobytes();
+  SymbolTable symbols;
+  ScannerIn scannerIn(program.data(), program.data() + program.size(), symbols, DIRECT_scan);
+  Tree tree;
+  std::ostringstream diag;
+  auto start = std::chrono::steady_clock::now();
+  NodeId root = parser(scannerIn, tree, diag, backend);
+  std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+  long peak = peakKilobytes();
+  if(root == NO_NODE) exitError(diag.str() + "ERROR Parse Failure");
+  
+  std::cout << "parse " << PARSER_NAMES[backend] << ": " << tree.size() << " nodes, "
+            << sizeof(Node) * tree.size() / 1024 << " KB of nodes, peak RSS " << peak << " KB (" << peak - before
+            << " KB for the parse), " << seconds.count() << "s" << std::endl;
+  
+  //Warnings of variables that are never used are printed to diag too
+  start = std::chrono::steady_clock::now();
+  std::unique_ptr<SemanticTable> table = buildTable(tree, root, symbols, diag);
+  seconds = std::chrono::steady_clock::now() - start;
+  if(table == nullptr) exitError(diag.str() + "ERROR Static Semantics Failure");
+  
+  std::cout << "check: " << seconds.count() << "s" << std::endl;
+  
+  return 0;
+}
+
+//Returns the most memory the process has had resident so far in kilobytes
+static long peakKilobytes()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/*
+ *  Description: Helper function that exits the program on an error.
+ *  Passed: Is passed a string to print.
+ *  Return: Exits the program
+ */
+static void exitError(const std::string S) 
+{
+  std::cout << S << std::endl;
+  exit(1);
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+//Parses a program once with the parser of the first commit, which builds a tree of unique_ptr nodes, and reports the
+//same things parseBench.cpp does for the arena tree (tree.h). make parse-bench copies it into that commit's sources
+//and builds it there, so parser.h and tree.h below are the old ones
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <sys/resource.h>
+
+#include "parser.h"
+#include "tree.h"
+
+//The old parser recurses once a statement, more than the main thread's stack has room for on a long program
+static const size_t PARSE_STACK_BYTES = 1ull << 30;
+
+//What the parse thread is passed and gives back
+struct ParseObj {
+  const char* filename;       //Program to parse
+  std::unique_ptr<Node> root; //Root of its tree, nullptr if it failed to parse
+  bool opened;                //If the program file could be opened
+};
+
+static void* parse(void* parseObj);
+static long peakKilobytes();
+static void exitError(const std::string S);
+
+
+int main(int argc, char *argv[])
+{
+  if(argc != 2) exitError("Usage: parsebench-baseline file.4280fs24");
+
+  //The old parser opens the file itself, so the peak before it counts no program
+  long before = peakKilobytes();
+  ParseObj parseObj = { argv[1], nullptr, true };
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, PARSE_STACK_BYTES);
+  pthread_t thread;
+  auto start = std::chrono::steady_clock::now();
+  if(pthread_create(&thread, &attr, parse, &parseObj) != 0) exitError("Could not start the parse thread");
+  pthread_join(thread, nullptr);
+  std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+  long peak = peakKilobytes();
+  pthread_attr_destroy(&attr);
+  if(!parseObj.opened) exitError(std::string("File does not exist! ") + argv[1]);
+  std::unique_ptr<Node>& root = parseObj.root;
+  if(root == nullptr) exitError("ERROR Parse Failure");
+
+  //Counted without recursion, a long program nests one mStat node in the next
+  size_t nodes = 0;
+  size_t bytes = 0;
+  std::vector<const Node*> stack = { root.get() };
+  while(!stack.empty())
+  {
+    const Node* node = stack.back();
+    stack.pop_back();
+    nodes++;
+    bytes += sizeof(Node) + node->label.capacity() + node->tokens.capacity() * sizeof(Token);
+    for(const Node* child : { node->child1.get(), node->child2.get(), node->child3.get(), node->child4.get() })
+      if(child != nullptr) stack.push_back(child);
+  }
+
+  std::cout << "parse baseline: " << nodes << " nodes, " << bytes / 1024 << " KB of nodes, peak RSS " << peak
+            << " KB (" << peak - before << " KB for the parse), " << seconds.count() << "s" << std::endl;
+
+  //Freeing the tree would recurse as deep as the program is long
+  root.release();
+
+  return 0;
+}
+
+/*
+ *  Description: Parses the program of a ParseObj with the old parser, run on a thread with a stack deep enough for it.
+ *  Passed: Is passed the ParseObj.
+ *  Return: Returns nullptr, the tree is left in the ParseObj
+ */
+static void* parse(void* parseObj)
+{
+  ParseObj& obj = *static_cast<ParseObj*>(parseObj);
+  try
+  {
+    obj.root = parser(obj.filename);
+  }
+  catch(const std::invalid_argument &e) //Program file could not be opened
+  {
+    obj.opened = false;
+  }
+  return nullptr;
+}
+
+//Returns the most memory the process has had resident so far in kilobytes
+static long peakKilobytes()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/*
+ *  Description: Helper function that exits the program on an error.
+ *  Passed: Is passed a string to print.
+ *  Return: Exits the program
+ */
+static void exitError(const std::string S)
+{
+  std::cout << S << std::endl;
+  exit(1);
+}
\ No newline at end of file
@@ -1,74 +1,91 @@
 #include <sstream>
 #include <iostream>
-#include <fstream>
-#include <unordered_set>
+#include <vector>
 
 #include "parser.h"
 #include "language.h"
 #include "scanner.h"
 #include "tree.h"
+#include "grammar.h"
 
 /*
  * Object for the scanner information to be passed throughout the program.
  */
 struct ScannerObj {
-  std::ifstream scannerIn; //File stream in for the scanner
-  Token scannerToken;      //Token the scanner just read in
+  ScannerIn &scannerIn; //Position of the scanner in the input buffer
+  Token scannerToken;   //Token the scanner just read in
+  Tree &tree;           //Where the nodes of the parse tree are allocated
 };
 
-static void getToken(ScannerObj &scannerObj);
-static void handleError(const std::string EXPECTED, const std::string GIVEN, const int LINE);
-
-static std::unique_ptr<Node> program(ScannerObj &scannerObj);
-static std::unique_ptr<Node> vars(ScannerObj &scannerObj);
-static std::unique_ptr<Node> block(ScannerObj &scannerObj);
-static std::unique_ptr<Node> varlist(ScannerObj &scannerObj);
-static std::unique_ptr<Node> varlist2(ScannerObj &scannerObj);
-
-static std::unique_ptr<Node> stats(ScannerObj &scannerObj);
-static std::unique_ptr<Node> mstat(ScannerObj &scannerObj);
-static std::unique_ptr<Node> stat(ScannerObj &scannerObj);
-static std::unique_ptr<Node> read(ScannerObj &scannerObj);
-static std::unique_ptr<Node> print(ScannerObj &scannerObj);
-static std::unique_ptr<Node> cond(ScannerObj &scannerObj);
-static std::unique_ptr<Node> iter(ScannerObj &scannerObj);
-static std::unique_ptr<Node> assign(ScannerObj &scannerObj);
-static std::unique_ptr<Node> relational(ScannerObj &scannerObj);
-
-static std::unique_ptr<Node> exp(ScannerObj &scannerObj);
-static std::unique_ptr<Node> exp2(ScannerObj &scannerObj);
-static std::unique_ptr<Node> M(ScannerObj &scannerObj);
-static std::unique_ptr<Node> M2(ScannerObj &scannerObj);
-static std::unique_ptr<Node> N(ScannerObj &scannerObj);
-static std::unique_ptr<Node> N2(ScannerObj &scannerObj);
-static std::unique_ptr<Node> R(ScannerObj &scannerObj);
 
+/*
+ * A symbol the table parser still has to parse and where it goes in the tree. A nonterminal under one that hands
+ * over its node (GrammarSymbol::handsOver) has no owner until the node is built.
+ */
+struct ParseEntry {
+  const GrammarSymbol* symbol; //The symbol of the production it came from
+  NodeId owner;                //Node the token of a terminal is added to or the node of a nonterminal is linked to
+  uint8_t slot;                //Child of owner the node of a nonterminal is, NEXT_SLOT for its next
+};
+
+static void getToken(ScannerObj &scannerObj);
+static void handleError(const std::string EXPECTED, const std::string_view GIVEN, const int LINE);
+static std::string_view tokenText(const ScannerObj &scannerObj);
+static bool isKeyword(const Token &TOKEN, const Keyword KEYWORD);
+static bool isStatement(const Keyword KEYWORD);
+static bool isRelational(const TokenKind KIND);
+
+static NodeId tableParser(ScannerObj &scannerObj);
+static bool matches(const GrammarSymbol& SYMBOL, const Token& TOKEN);
+static void expand(ScannerObj &scannerObj, const ParseEntry ENTRY, std::vector<ParseEntry>& stack, NodeId& root);
+static void linkNode(Tree& tree, const NodeId OWNER, const uint8_t SLOT, const NodeId NODE);
+
+static NodeId program(ScannerObj &scannerObj);
+static NodeId vars(ScannerObj &scannerObj);
+static NodeId block(ScannerObj &scannerObj);
+static NodeId varlist(ScannerObj &scannerObj);
+
+static NodeId stats(ScannerObj &scannerObj);
+static NodeId stat(ScannerObj &scannerObj);
+static NodeId read(ScannerObj &scannerObj);
+static NodeId print(ScannerObj &scannerObj);
+static NodeId cond(ScannerObj &scannerObj);
+static NodeId iter(ScannerObj &scannerObj);
+static NodeId assign(ScannerObj &scannerObj);
+static NodeId relational(ScannerObj &scannerObj);
+
+static NodeId exp(ScannerObj &scannerObj);
+static NodeId exp2(ScannerObj &scannerObj);
+static NodeId M(ScannerObj &scannerObj);
+static NodeId M2(ScannerObj &scannerObj);
+static NodeId N(ScannerObj &scannerObj);
+static NodeId N2(ScannerObj &scannerObj);
+static NodeId R(ScannerObj &scannerObj);
+
+
+const char* const PARSER_NAMES[PARSERS] = { "descent", "table" };
 
 /*
- * Auxiliary function for the parser. Opens the file passed by FILENAME
- * and calls the first nonterminal in the BNF. Catches any invalid_argument
- * errors thrown by the program. Returns NULL if a error was found when parsing
- * or returns the root of the parse tree.
+ * Auxiliary function for the parser. Scans the buffer scannerIn points at
+ * and parses it with BACKEND from the first nonterminal in the BNF. Catches any invalid_argument
+ * errors thrown by the program and prints them to diag. Returns NO_NODE if a error was found when parsing
+ * or returns the root of the parse tree. The nodes are allocated in tree.
  */
-std::unique_ptr<Node> parser(const std::string FILENAME) 
+NodeId parser(ScannerIn &scannerIn, Tree &tree, std::ostream &diag, const ParserBackend BACKEND) 
 {
-  ScannerObj scannerObj; //Object to pass 
-  scannerObj.scannerIn.open(FILENAME.c_str());
-  if (!scannerObj.scannerIn.is_open()) 
-  {
-    throw std::invalid_argument("ERROR: scannerIn failed to open");
-  }
-  std::unique_ptr<Node> root = nullptr;
+  ScannerObj scannerObj = { scannerIn, Token(), tree }; //Object to pass 
+  NodeId root = NO_NODE;
 
   try
   {
     getToken(scannerObj);
-    root = program(scannerObj); //Call the first nonterminal in the BNF
+    if(BACKEND == TABLE_parse) root = tableParser(scannerObj);
+    else root = program(scannerObj); //Call the first nonterminal in the BNF
   }
   catch(const std::invalid_argument &e) //Scanner or Parser found a error
   {
-    std::cout << std::endl << e.what() << std::endl;
-    return nullptr;
+    diag << std::endl << e.what() << std::endl;
+    return NO_NODE;
   }
   
   return root;
@@ -77,7 +94,7 @@ std::unique_ptr<Node> parser(const std::string FILENAME)
 
 //Helper function print error messages and throw a invalid_argumnet excetption
 //Passed what the parser expected to see, what it was actually given, and what line it was on.
-static void handleError(const std::string EXPECTED, const std::string GIVEN, const int LINE)
+static void handleError(const std::string EXPECTED, const std::string_view GIVEN, const int LINE)
 {
   std::stringstream error; 
   error << "ERROR || Expected: " << EXPECTED << " || Given: " << GIVEN << " || Line: " << LINE;
@@ -90,28 +107,156 @@ static void getToken(ScannerObj &scannerObj)
   scannerObj.scannerToken = scanner(scannerObj.scannerIn);
 }
 
+//Helper function to get the text of the token the scanner just read in for error messages
+static std::string_view tokenText(const ScannerObj &scannerObj)
+{
+  return symbolText(scannerObj.scannerIn, scannerObj.scannerToken.symbol);
+}
+
+//Helper function to check if TOKEN is the keyword KEYWORD
+static bool isKeyword(const Token &TOKEN, const Keyword KEYWORD)
+{
+  return TOKEN.kind == KEYWORD_tk && TOKEN.keyword == KEYWORD;
+}
+
+//Helper function to check if KEYWORD starts a statement
+static bool isStatement(const Keyword KEYWORD)
+{
+  switch(KEYWORD)
+  {
+    case READ_kw: case PRINT_kw: case START_kw: case IFF_kw: case ITERATE_kw: case SET_kw:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//Helper function to check if KIND is a relational operator
+static bool isRelational(const TokenKind KIND)
+{
+  switch(KIND)
+  {
+    case LESSEQUAL_tk: case LESSTHAN_tk: case GREATEREQUAL_tk: case GREATERTHAN_tk: case TILDE_tk: case ASTERISK_tk:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/*
+ * Table driven parser. Keeps the symbols left to parse on a stack starting with <program>. A terminal on top has to
+ * match the token the scanner just read in, a nonterminal is replaced by the production PARSE_TABLE (grammar.h) takes
+ * for that token. Nodes are built as their nonterminal is replaced, in the same order the functions below build them.
+ * Returns the root of the parse tree.
+ */
+static NodeId tableParser(ScannerObj &scannerObj)
+{
+  static const GrammarSymbol START = nt(PROGRAM_nt);
+  NodeId root = NO_NODE;
+  std::vector<ParseEntry> stack;
+  stack.reserve(64);
+  stack.push_back({ &START, NO_NODE, 0 });
+  
+  while(!stack.empty())
+  {
+    ParseEntry entry = stack.back();
+    stack.pop_back();
+    if(!entry.symbol->terminal)
+    {
+      expand(scannerObj, entry, stack, root);
+      continue;
+    }
+    
+    const Token token = scannerObj.scannerToken;
+    if(!matches(*entry.symbol, token)) handleError(entry.symbol->expected, tokenText(scannerObj), token.line);
+    if(entry.symbol->link == KEEP_ln) scannerObj.tree[entry.owner].addToken(token);
+    if(token.kind != EOF_tk) getToken(scannerObj); //Nothing is read past the end
+  }
+  
+  return root;
+}
+
+//Helper function to check if TOKEN is the terminal SYMBOL
+static bool matches(const GrammarSymbol& SYMBOL, const Token& TOKEN)
+{
+  return SYMBOL.id == ANY_KEYWORD ? TOKEN.kind == KEYWORD_tk : lookahead(TOKEN) == SYMBOL.id;
+}
+
+/*
+ * Helper function of the table parser that replaces the nonterminal of ENTRY on the stack with its production for
+ * the token the scanner just read in and builds the node of the production. The node of the first production is
+ * the root. A production starting with a terminal is only taken on that terminal so it is read in at once.
+ */
+static void expand(ScannerObj &scannerObj, const ParseEntry ENTRY, std::vector<ParseEntry>& stack, NodeId& root)
+{
+  const Token& token = scannerObj.scannerToken;
+  uint8_t p = PARSE_TABLE[ENTRY.symbol->id][lookahead(token)];
+  if(p == NO_PRODUCTION)
+    handleError(NONTERMINAL_ERRORS[ENTRY.symbol->id].expected, tokenText(scannerObj), token.line);
+  const Production& production = GRAMMAR[p];
+  
+  NodeId owner = ENTRY.owner;
+  if(production.node != NODEKINDS)
+  {
+    owner = scannerObj.tree.newNode(production.node);
+    if(ENTRY.owner == NO_NODE) root = owner;
+    else linkNode(scannerObj.tree, ENTRY.owner, ENTRY.slot, owner);
+    if(ENTRY.symbol->handsOver) stack.back().owner = owner;
+  }
+  
+  int first = 0;
+  if(production.length != 0 && production.body[0].terminal)
+  {
+    if(production.body[0].link == KEEP_ln) scannerObj.tree[owner].addToken(token);
+    getToken(scannerObj);
+    first = 1;
+  }
+  
+  //The rest of the body goes on the stack last symbol first
+  for(int i = production.length - 1; i >= first; i--)
+  {
+    const GrammarSymbol& symbol = production.body[i];
+    if(symbol.slot == INHERIT_SLOT) stack.push_back({ &symbol, ENTRY.owner, ENTRY.slot });
+    else stack.push_back({ &symbol, symbol.link == AFTER_ln ? NO_NODE : owner, symbol.slot });
+  }
+}
+
+//Helper function to link NODE to OWNER as its child SLOT or as its next when SLOT is NEXT_SLOT
+static void linkNode(Tree& tree, const NodeId OWNER, const uint8_t SLOT, const NodeId NODE)
+{
+  Node& owner = tree[OWNER];
+  switch(SLOT)
+  {
+    case 0: owner.child1 = NODE; break;
+    case 1: owner.child2 = NODE; break;
+    case 2: owner.child3 = NODE; break;
+    case 3: owner.child4 = NODE; break;
+    default: owner.next = NODE; break;
+  }
+}
+
 /* Function for the non-terminal program in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <program> -> program <vars> <block>
  */
-static std::unique_ptr<Node> program(ScannerObj &scannerObj) 
+static NodeId program(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode= new Node("program");
-  std::unique_ptr<Node> returnNode(new Node("program"));
+  NodeId returnId = scannerObj.tree.newNode(PROGRAM_nd);
+  Node& returnNode = scannerObj.tree[returnId];
 
-  if(scannerObj.scannerToken.tokenId != "KEYWORD_tk" && scannerObj.scannerToken.instance != "program")
-    handleError("program", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(scannerObj.scannerToken.kind != KEYWORD_tk && !isKeyword(scannerObj.scannerToken, PROGRAM_kw))
+    handleError("program", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
   
-  returnNode->child1 = vars(scannerObj);
+  returnNode.child1 = vars(scannerObj);
   
-  returnNode->child2 = block(scannerObj);
+  returnNode.child2 = block(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "EOF_tk") //Make sure all tokens out of the file are used
-    handleError("EOF", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(scannerObj.scannerToken.kind != EOF_tk) //Make sure all tokens out of the file are used
+    handleError("EOF", tokenText(scannerObj), scannerObj.scannerToken.line);
   
-  return returnNode;
+  return returnId;
 }
 
 
@@ -119,371 +264,342 @@ static std::unique_ptr<Node> program(ScannerObj &scannerObj)
  * the nonterminal. Returns the node made.
  * <vars> -> empty | var <varList>
  */
-static std::unique_ptr<Node> vars(ScannerObj &scannerObj)
+static NodeId vars(ScannerObj &scannerObj)
 {
-  //std::unique_ptr<Node> returnNode = new Node("vars");
-  std::unique_ptr<Node> returnNode(new Node("vars"));
+  NodeId returnId = scannerObj.tree.newNode(VARS_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  if(scannerObj.scannerToken.tokenId == "KEYWORD_tk" && scannerObj.scannerToken.instance == "var")
+  if(isKeyword(scannerObj.scannerToken, VAR_kw))
   {
     getToken(scannerObj);
     
-    returnNode->child1 = varlist(scannerObj);
+    returnNode.child1 = varlist(scannerObj);
     
-    return returnNode;
+    return returnId;
   }
 
-  return returnNode; //Empty
+  return returnId; //Empty
 }
 
-/* Function for the non-terminal varlist in the BNF. Builds a node based on the structure of
- * the nonterminal. Returns the node made.
- * <varList> -> identifier , integer <varlist2>
+/* Function for the non-terminal varlist in the BNF. Builds a node for every variable in the list
+ * and links them through next. Returns the first node made.
+ * <varList>  -> identifier , integer <varlist2>
+ * <varlist2> -> ; | <varList>
  */
-static std::unique_ptr<Node> varlist(ScannerObj &scannerObj) 
+static NodeId varlist(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode = new Node("varlist");
-  std::unique_ptr<Node> returnNode(new Node("varlist"));
+  NodeId returnId = NO_NODE;
+  NodeId lastId = NO_NODE;
   
-  if(scannerObj.scannerToken.tokenId != "ID_tk") 
-    handleError("identifier", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  while(true) //One pass per identifier , integer
+  {
+    NodeId itemId = scannerObj.tree.newNode(VARLIST_nd);
+    Node& itemNode = scannerObj.tree[itemId];
     
-  returnNode->tokens.push_back(scannerObj.scannerToken);
-  getToken(scannerObj);
-  
-  if(scannerObj.scannerToken.tokenId != "COMMA_tk") 
-    handleError(",", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+    if(lastId == NO_NODE) returnId = itemId;
+    else scannerObj.tree[lastId].next = itemId;
+    lastId = itemId;
     
-  getToken(scannerObj);
-  
-  if(scannerObj.scannerToken.tokenId != "INT_tk") 
-    handleError("integer", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+    if(scannerObj.scannerToken.kind != ID_tk) 
+      handleError("identifier", tokenText(scannerObj), scannerObj.scannerToken.line);
+      
+    itemNode.addToken(scannerObj.scannerToken);
+    getToken(scannerObj);
     
-  returnNode->tokens.push_back(scannerObj.scannerToken);
-  getToken(scannerObj);
-  
-  returnNode->child1 = varlist2(scannerObj);
-
-  return returnNode;
-}
-
-/* Function for the non-terminal varlist2 in the BNF. Builds a node based on the structure of
- * the nonterminal. Returns the node made.
- * <varlist2> -> ; | <varList>
- */
-static std::unique_ptr<Node> varlist2(ScannerObj &scannerObj)
-{
-  //std::unique_ptr<Node> returnNode = new Node("varlist2");
-  std::unique_ptr<Node> returnNode(new Node("varlist2"));
-  
-  if(scannerObj.scannerToken.tokenId == "SEMICOLON_tk")
-  {
+    if(scannerObj.scannerToken.kind != COMMA_tk) 
+      handleError(",", tokenText(scannerObj), scannerObj.scannerToken.line);
+      
+    getToken(scannerObj);
+    
+    if(scannerObj.scannerToken.kind != INT_tk) 
+      handleError("integer", tokenText(scannerObj), scannerObj.scannerToken.line);
+      
+    itemNode.addToken(scannerObj.scannerToken);
     getToken(scannerObj);
-    return returnNode;
+    
+    if(scannerObj.scannerToken.kind == SEMICOLON_tk) //<varlist2> -> ;
+    {
+      getToken(scannerObj);
+      return returnId;
+    }
   }
-  
-  returnNode->child1 = varlist(scannerObj);
-
-  return returnNode;
 }
 
 
 /* Function for the non-terminal stats in the BNF. Builds a node based on the structure of
- * the nonterminal. Returns the node made.
+ * the nonterminal. The statements are parsed in a loop and linked through next from child1.
+ * Returns the node made.
  * <stats> -> <stat> <mStat>
- */
-static std::unique_ptr<Node> stats(ScannerObj &scannerObj) 
-{
-  //std::unique_ptr<Node> returnNode = new Node("stats");
-  std::unique_ptr<Node> returnNode(new Node("stats"));
-  
-  returnNode->child1 = stat(scannerObj);
-  
-  returnNode->child2 = mstat(scannerObj);
-  
-  return returnNode;
-}
-
-/* Function for the non-terminal mstat in the BNF. Builds a node based on the structure of
- * the nonterminal. Returns the node made.
  * <mStat> -> empty | <stat> <mStat>
  */
-static std::unique_ptr<Node> mstat(ScannerObj &scannerObj) 
+static NodeId stats(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode = new Node("mstat");
-  std::unique_ptr<Node> returnNode(new Node("mstat"));
-
-  //set to make it easier to search if we have a statement keyword
-  const std::unordered_set<std::string> STATS = {"read", "print", "start", "iff", "iterate", "set"};
+  NodeId returnId = scannerObj.tree.newNode(STATS_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  if(scannerObj.scannerToken.tokenId != "KEYWORD_tk") //Make sure its a keyword
-    handleError("Statement Keyword", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
-
-  if(STATS.find(scannerObj.scannerToken.instance) != STATS.end())
-  {
-    returnNode->child1 = stat(scannerObj);
+  NodeId lastId = stat(scannerObj);
+  returnNode.child1 = lastId;
   
-    returnNode->child2 = mstat(scannerObj);
+  while(true) //<mStat>
+  {
+    if(scannerObj.scannerToken.kind != KEYWORD_tk) //Make sure its a keyword
+      handleError("Statement Keyword", tokenText(scannerObj), scannerObj.scannerToken.line);
     
-    return returnNode;
+    if(!isStatement(scannerObj.scannerToken.keyword)) return returnId; //Empty
+    
+    NodeId statId = stat(scannerObj);
+    scannerObj.tree[lastId].next = statId;
+    lastId = statId;
   }
-  
-  
-  //return returnNode; //Empty
-  return nullptr;
 }
 
 /* Function for the non-terminal stat in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <stat> -> <read> | <print> | <block> | <cond> | <iter> | <assign>
  */
-static std::unique_ptr<Node> stat(ScannerObj &scannerObj) 
+static NodeId stat(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode = new Node("stat");
-  std::unique_ptr<Node> returnNode(new Node("stat"));
+  NodeId returnId = scannerObj.tree.newNode(STAT_nd);
+  Node& returnNode = scannerObj.tree[returnId];
 
-  if(scannerObj.scannerToken.tokenId != "KEYWORD_tk")
-    handleError("Statement Keyword", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(scannerObj.scannerToken.kind != KEYWORD_tk)
+    handleError("Statement Keyword", tokenText(scannerObj), scannerObj.scannerToken.line);
 
-  if(scannerObj.scannerToken.instance == "read") //Case 1
+  if(isKeyword(scannerObj.scannerToken, READ_kw)) //Case 1
   {
-    returnNode->child1 = read(scannerObj);
-    return returnNode;
+    returnNode.child1 = read(scannerObj);
+    return returnId;
   } 
-  else if(scannerObj.scannerToken.instance == "print") 
+  else if(isKeyword(scannerObj.scannerToken, PRINT_kw)) 
   {
-    returnNode->child1 = print(scannerObj);
-    return returnNode;
+    returnNode.child1 = print(scannerObj);
+    return returnId;
   } 
-  else if(scannerObj.scannerToken.instance == "start") 
+  else if(isKeyword(scannerObj.scannerToken, START_kw)) 
   {
-    returnNode->child1 = block(scannerObj);
-    return returnNode;
+    returnNode.child1 = block(scannerObj);
+    return returnId;
   } 
-  else if(scannerObj.scannerToken.instance == "iff") 
+  else if(isKeyword(scannerObj.scannerToken, IFF_kw)) 
   {
-    returnNode->child1 = cond(scannerObj);
-    return returnNode;
+    returnNode.child1 = cond(scannerObj);
+    return returnId;
   } 
-  else if(scannerObj.scannerToken.instance == "iterate") 
+  else if(isKeyword(scannerObj.scannerToken, ITERATE_kw)) 
   {
-    returnNode->child1 = iter(scannerObj);
-    return returnNode;
+    returnNode.child1 = iter(scannerObj);
+    return returnId;
   } 
-  else if(scannerObj.scannerToken.instance == "set") 
+  else if(isKeyword(scannerObj.scannerToken, SET_kw)) 
   {
-    returnNode->child1 = assign(scannerObj);
-    return returnNode;
+    returnNode.child1 = assign(scannerObj);
+    return returnId;
   }
      
-  handleError("Statement Keyword", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  handleError("Statement Keyword", tokenText(scannerObj), scannerObj.scannerToken.line);
   
-  return returnNode;
+  return returnId;
 }
 
 /* Function for the non-terminal block in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <block> -> start <vars> <stats> stop
  */
-static std::unique_ptr<Node> block(ScannerObj &scannerObj) 
+static NodeId block(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode = new Node("block");
-  std::unique_ptr<Node> returnNode(new Node("block"));
+  NodeId returnId = scannerObj.tree.newNode(BLOCK_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  if(scannerObj.scannerToken.tokenId != "KEYWORDS_tk" && scannerObj.scannerToken.instance != "start")
-    handleError("start", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(!isKeyword(scannerObj.scannerToken, START_kw))
+    handleError("start", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
   
-  returnNode->child1 = vars(scannerObj);
+  returnNode.child1 = vars(scannerObj);
   
-  returnNode->child2 = stats(scannerObj);
+  returnNode.child2 = stats(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "KEYWORDS_tk" && scannerObj.scannerToken.instance != "stop")
-    handleError("stop", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(!isKeyword(scannerObj.scannerToken, STOP_kw))
+    handleError("stop", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
   
-  return returnNode;
+  return returnId;
 }
 
 /* Function for the non-terminal read in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <read> -> read identifier ;
  */
-static std::unique_ptr<Node> read(ScannerObj &scannerObj) 
+static NodeId read(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode = new Node("read");
-  std::unique_ptr<Node> returnNode(new Node("read"));
+  NodeId returnId = scannerObj.tree.newNode(READ_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  if(scannerObj.scannerToken.tokenId != "KEYWORDS_tk" && scannerObj.scannerToken.instance != "read")
-    handleError("read", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(!isKeyword(scannerObj.scannerToken, READ_kw))
+    handleError("read", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "ID_tk")
-    handleError("Identifier", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
-  returnNode->tokens.push_back(scannerObj.scannerToken);
+  if(scannerObj.scannerToken.kind != ID_tk)
+    handleError("Identifier", tokenText(scannerObj), scannerObj.scannerToken.line);
+  returnNode.addToken(scannerObj.scannerToken);
   
   getToken(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "SEMICOLON_tk")
-    handleError(";", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(scannerObj.scannerToken.kind != SEMICOLON_tk)
+    handleError(";", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
     
     
-  return returnNode;
+  return returnId;
 }
 
 /* Function for the non-terminal print in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <print> -> print <exp> ;
  */
-static std::unique_ptr<Node> print(ScannerObj &scannerObj) 
+static NodeId print(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode = new Node("print");
-  std::unique_ptr<Node> returnNode(new Node("print"));
+  NodeId returnId = scannerObj.tree.newNode(PRINT_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  if(scannerObj.scannerToken.tokenId != "KEYWORDS_tk" && scannerObj.scannerToken.instance != "print")
-    handleError("print", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(!isKeyword(scannerObj.scannerToken, PRINT_kw))
+    handleError("print", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
   
-  returnNode->child1 = exp(scannerObj);
+  returnNode.child1 = exp(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "SEMICOLON_tk")
-    handleError(";", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(scannerObj.scannerToken.kind != SEMICOLON_tk)
+    handleError(";", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
   
-  return returnNode;
+  return returnId;
 }
 
 /* Function for the non-terminal cond in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <cond> -> iff [ <exp> <relational> <exp> ] <stat>
  */
-static std::unique_ptr<Node> cond(ScannerObj &scannerObj) 
+static NodeId cond(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode = new Node("cond");
-  std::unique_ptr<Node> returnNode(new Node("cond"));
+  NodeId returnId = scannerObj.tree.newNode(COND_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  if(scannerObj.scannerToken.tokenId != "KEYWORDS_tk" && scannerObj.scannerToken.instance != "iff")
-    handleError("iff", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(!isKeyword(scannerObj.scannerToken, IFF_kw))
+    handleError("iff", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "LEFTBRACKET_tk")
-    handleError("[", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(scannerObj.scannerToken.kind != LEFTBRACKET_tk)
+    handleError("[", tokenText(scannerObj), scannerObj.scannerToken.line);
     
-  returnNode->tokens.push_back(scannerObj.scannerToken);
+  returnNode.addToken(scannerObj.scannerToken);
   getToken(scannerObj);
   
-  returnNode->child1 = exp(scannerObj);
+  returnNode.child1 = exp(scannerObj);
   
-  returnNode->child2 = relational(scannerObj);
+  returnNode.child2 = relational(scannerObj);
   
-  returnNode->child3 = exp(scannerObj);
+  returnNode.child3 = exp(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "RIGHTBRACKET_tk")
-    handleError("]", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(scannerObj.scannerToken.kind != RIGHTBRACKET_tk)
+    handleError("]", tokenText(scannerObj), scannerObj.scannerToken.line);
     
-  returnNode->tokens.push_back(scannerObj.scannerToken);
+  returnNode.addToken(scannerObj.scannerToken);
   getToken(scannerObj); 
   
-  returnNode->child4 = stat(scannerObj);
+  returnNode.child4 = stat(scannerObj);
   
-  return returnNode;
+  return returnId;
 }
 
 /* Function for the non-terminal iter in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <iter> -> iterate [ <exp> <relational> <exp> ] <stat>
  */
-static std::unique_ptr<Node> iter(ScannerObj &scannerObj) 
+static NodeId iter(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode = new Node("iter");
-  std::unique_ptr<Node> returnNode(new Node("iter"));
+  NodeId returnId = scannerObj.tree.newNode(ITER_nd);
+  Node& returnNode = scannerObj.tree[returnId];
 
-  if(scannerObj.scannerToken.tokenId != "KEYWORDS_tk" && scannerObj.scannerToken.instance != "iterate")
-    handleError("iterate", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(!isKeyword(scannerObj.scannerToken, ITERATE_kw))
+    handleError("iterate", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "LEFTBRACKET_tk")
-    handleError("[", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
-  returnNode->tokens.push_back(scannerObj.scannerToken);
+  if(scannerObj.scannerToken.kind != LEFTBRACKET_tk)
+    handleError("[", tokenText(scannerObj), scannerObj.scannerToken.line);
+  returnNode.addToken(scannerObj.scannerToken);
   
   getToken(scannerObj);
   
-  returnNode->child1 = exp(scannerObj);
+  returnNode.child1 = exp(scannerObj);
   
-  returnNode->child2 = relational(scannerObj);
+  returnNode.child2 = relational(scannerObj);
   
-  returnNode->child3 = exp(scannerObj);
+  returnNode.child3 = exp(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "RIGHTBRACKET_tk")
-    handleError("]", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(scannerObj.scannerToken.kind != RIGHTBRACKET_tk)
+    handleError("]", tokenText(scannerObj), scannerObj.scannerToken.line);
     
-  returnNode->tokens.push_back(scannerObj.scannerToken);
+  returnNode.addToken(scannerObj.scannerToken);
   getToken(scannerObj); 
   
-  returnNode->child4 = stat(scannerObj);
+  returnNode.child4 = stat(scannerObj);
 
-  return returnNode;
+  return returnId;
 }
 
 /* Function for the non-terminal assign in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <assign> -> set identifier <exp> ;
  */ 
-static std::unique_ptr<Node> assign(ScannerObj &scannerObj) 
+static NodeId assign(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode = new Node("assign");
-  std::unique_ptr<Node> returnNode(new Node("assign"));
+  NodeId returnId = scannerObj.tree.newNode(ASSIGN_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  if(scannerObj.scannerToken.tokenId != "KEYWORDS_tk" && scannerObj.scannerToken.instance != "set")
-    handleError("set", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(!isKeyword(scannerObj.scannerToken, SET_kw))
+    handleError("set", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "ID_tk")
-    handleError("identifier", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
-  returnNode->tokens.push_back(scannerObj.scannerToken);
+  if(scannerObj.scannerToken.kind != ID_tk)
+    handleError("identifier", tokenText(scannerObj), scannerObj.scannerToken.line);
+  returnNode.addToken(scannerObj.scannerToken);
   
   getToken(scannerObj);
   
-  returnNode->child1 = exp(scannerObj);
+  returnNode.child1 = exp(scannerObj);
   
-  if(scannerObj.scannerToken.tokenId != "SEMICOLON_tk")
-    handleError(";", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(scannerObj.scannerToken.kind != SEMICOLON_tk)
+    handleError(";", tokenText(scannerObj), scannerObj.scannerToken.line);
     
   getToken(scannerObj);
   
-  return returnNode;
+  return returnId;
 }
 
 /* Function for the non-terminal relational in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <relational> -> .le. | .ge. | .lt. | .gt. | ** | ~
  */
-static std::unique_ptr<Node> relational(ScannerObj &scannerObj) 
+static NodeId relational(ScannerObj &scannerObj) 
 {
-  //std::unique_ptr<Node> returnNode = new Node("relational");
-  std::unique_ptr<Node> returnNode(new Node("relational"));
-  
-  //Set to make it easier to search if the current token is a relational operator
-  const std::unordered_set<std::string> RELATIONAL = 
-    {"LESSEQUAL_tk", "LESSTHAN_tk", "GREATEREQUAL_tk", "GREATERTHAN_tk", "TILDE_tk", "ASTERISK_tk"};
+  NodeId returnId = scannerObj.tree.newNode(RELATIONAL_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  if(RELATIONAL.find(scannerObj.scannerToken.tokenId) == RELATIONAL.end())
-    handleError("relational operator", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  if(!isRelational(scannerObj.scannerToken.kind))
+    handleError("relational operator", tokenText(scannerObj), scannerObj.scannerToken.line);
     
-  returnNode->tokens.push_back(scannerObj.scannerToken);
+  returnNode.addToken(scannerObj.scannerToken);
   getToken(scannerObj);
 
-  return returnNode;
+  return returnId;
 }
 
 
@@ -491,177 +607,177 @@ static std::unique_ptr<Node> relational(ScannerObj &scannerObj)
  * the nonterminal. Returns the node made.
  * <exp> -> <M> <exp2>
  */
-static std::unique_ptr<Node> exp(ScannerObj &scannerObj)
+static NodeId exp(ScannerObj &scannerObj)
 {
-  //std::unique_ptr<Node> returnNode = new Node("exp");
-  std::unique_ptr<Node> returnNode(new Node("exp"));
+  NodeId returnId = scannerObj.tree.newNode(EXP_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  returnNode->child1 = M(scannerObj);
+  returnNode.child1 = M(scannerObj);
   
-  returnNode->child2 = exp2(scannerObj);
+  returnNode.child2 = exp2(scannerObj);
 
-  return returnNode;
+  return returnId;
 }
 
 /* Function for the non-terminal exp2 in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <exp2> -> + <exp> | - <exp> | empty
  */
-static std::unique_ptr<Node> exp2(ScannerObj &scannerObj)
+static NodeId exp2(ScannerObj &scannerObj)
 {
-  //std::unique_ptr<Node> returnNode = new Node("exp2");
-  std::unique_ptr<Node> returnNode(new Node("exp2"));
-  
-  if(scannerObj.scannerToken.tokenId == "PLUS_tk") //Case 1
+  if(scannerObj.scannerToken.kind == PLUS_tk) //Case 1
   {
-    returnNode->tokens.push_back(scannerObj.scannerToken);
+    NodeId returnId = scannerObj.tree.newNode(EXP2_nd); //Only allocate the node when it is not empty
+    Node& returnNode = scannerObj.tree[returnId];
+    
+    returnNode.addToken(scannerObj.scannerToken);
     getToken(scannerObj);
     
-    returnNode->child1 = exp(scannerObj);
+    returnNode.child1 = exp(scannerObj);
     
-    return returnNode;
+    return returnId;
   }
-  else if(scannerObj.scannerToken.tokenId == "MINUS_tk") //Case 2
+  else if(scannerObj.scannerToken.kind == MINUS_tk) //Case 2
   {
-    returnNode->tokens.push_back(scannerObj.scannerToken);
+    NodeId returnId = scannerObj.tree.newNode(EXP2_nd);
+    Node& returnNode = scannerObj.tree[returnId];
+    
+    returnNode.addToken(scannerObj.scannerToken);
     getToken(scannerObj);
     
-    returnNode->child1 = exp(scannerObj);
+    returnNode.child1 = exp(scannerObj);
     
-    return returnNode;
+    return returnId;
   }
 
-  //return returnNode; //Empty
-  return nullptr;
+  return NO_NODE; //Empty
 }
 
 /* Function for the non-terminal M in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <M> -> <N> <M2>
  */
-static std::unique_ptr<Node> M(ScannerObj &scannerObj)
+static NodeId M(ScannerObj &scannerObj)
 {
-  //std::unique_ptr<Node> returnNode = new Node("M");
-  std::unique_ptr<Node> returnNode(new Node("M"));
+  NodeId returnId = scannerObj.tree.newNode(M_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  returnNode->child1 = N(scannerObj);
+  returnNode.child1 = N(scannerObj);
   
-  returnNode->child2 = M2(scannerObj);
+  returnNode.child2 = M2(scannerObj);
   
-  return returnNode;
+  return returnId;
 }
 
 /* Function for the non-terminal M2 in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <M2> -> % <M> | empty
  */
-static std::unique_ptr<Node> M2(ScannerObj &scannerObj)
+static NodeId M2(ScannerObj &scannerObj)
 {
-  //std::unique_ptr<Node> returnNode = new Node("M2");
-  std::unique_ptr<Node> returnNode(new Node("M2"));
-  
-  if(scannerObj.scannerToken.tokenId == "PERCENT_tk") //Case 1
+  if(scannerObj.scannerToken.kind == PERCENT_tk) //Case 1
   {
-    returnNode->tokens.push_back(scannerObj.scannerToken);
+    NodeId returnId = scannerObj.tree.newNode(M2_nd); //Only allocate the node when it is not empty
+    Node& returnNode = scannerObj.tree[returnId];
+    
+    returnNode.addToken(scannerObj.scannerToken);
     getToken(scannerObj);
     
-    returnNode->child1 = M(scannerObj);
+    returnNode.child1 = M(scannerObj);
     
-    return returnNode;
+    return returnId;
   }
 
-  //return returnNode; //Empty
-  return nullptr;
+  return NO_NODE; //Empty
 }
 
 /* Function for the non-terminal N in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <N> -> <R> <N2> | - <N>
  */
-static std::unique_ptr<Node> N(ScannerObj &scannerObj)
+static NodeId N(ScannerObj &scannerObj)
 {
-  //std::unique_ptr<Node> returnNode = new Node("N");
-  std::unique_ptr<Node> returnNode(new Node("N"));
+  NodeId returnId = scannerObj.tree.newNode(N_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  if(scannerObj.scannerToken.tokenId == "MINUS_tk") //Case 1
+  if(scannerObj.scannerToken.kind == MINUS_tk) //Case 1
   {
-    returnNode->tokens.push_back(scannerObj.scannerToken);
+    returnNode.addToken(scannerObj.scannerToken);
     getToken(scannerObj);
     
-    returnNode->child1 = N(scannerObj);
+    returnNode.child1 = N(scannerObj);
     
-    return returnNode;
+    return returnId;
   }
   //Case 2
-  returnNode->child1 = R(scannerObj);
+  returnNode.child1 = R(scannerObj);
   
-  returnNode->child2 = N2(scannerObj);
+  returnNode.child2 = N2(scannerObj);
 
-  return returnNode;
+  return returnId;
 }
 
 /* Function for the non-terminal N2 in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <N2> -> / <N> | empty
  */
-static std::unique_ptr<Node> N2(ScannerObj &scannerObj)
+static NodeId N2(ScannerObj &scannerObj)
 {
-  //std::unique_ptr<Node> returnNode = new Node("N2");
-  std::unique_ptr<Node> returnNode(new Node("N2"));
-  
-  if(scannerObj.scannerToken.tokenId == "FORWARDSLASH_tk") //Case 1
+  if(scannerObj.scannerToken.kind == FORWARDSLASH_tk) //Case 1
   {
-    returnNode->tokens.push_back(scannerObj.scannerToken);
+    NodeId returnId = scannerObj.tree.newNode(N2_nd); //Only allocate the node when it is not empty
+    Node& returnNode = scannerObj.tree[returnId];
+    
+    returnNode.addToken(scannerObj.scannerToken);
     getToken(scannerObj);
     
-    returnNode->child1 = N(scannerObj);
+    returnNode.child1 = N(scannerObj);
     
-    return returnNode;
+    return returnId;
   }
 
-  //return returnNode; //Empty
-  return nullptr;
+  return NO_NODE; //Empty
 }
 
 /* Function for the non-terminal R in the BNF. Builds a node based on the structure of
  * the nonterminal. Returns the node made.
  * <R> -> ( <exp> ) | identifier | integer
  */
-static std::unique_ptr<Node> R(ScannerObj &scannerObj)
+static NodeId R(ScannerObj &scannerObj)
 {
-  //std::unique_ptr<Node> returnNode = new Node("R");
-  std::unique_ptr<Node> returnNode(new Node("R"));
+  NodeId returnId = scannerObj.tree.newNode(R_nd);
+  Node& returnNode = scannerObj.tree[returnId];
   
-  if(scannerObj.scannerToken.tokenId == "LEFTPAREN_tk") //Case 1
+  if(scannerObj.scannerToken.kind == LEFTPAREN_tk) //Case 1
   {
-    returnNode->tokens.push_back(scannerObj.scannerToken);
+    returnNode.addToken(scannerObj.scannerToken);
     getToken(scannerObj);
     
-    returnNode->child1 = exp(scannerObj);
+    returnNode.child1 = exp(scannerObj);
     
-    if(scannerObj.scannerToken.tokenId != "RIGHTPAREN_tk")
-      handleError(")", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+    if(scannerObj.scannerToken.kind != RIGHTPAREN_tk)
+      handleError(")", tokenText(scannerObj), scannerObj.scannerToken.line);
       
-    returnNode->tokens.push_back(scannerObj.scannerToken);
+    returnNode.addToken(scannerObj.scannerToken);
     getToken(scannerObj);
     
-    return returnNode;
+    return returnId;
   }
-  else if(scannerObj.scannerToken.tokenId == "ID_tk") //Case 2
+  else if(scannerObj.scannerToken.kind == ID_tk) //Case 2
   {
-    returnNode->tokens.push_back(scannerObj.scannerToken);
+    returnNode.addToken(scannerObj.scannerToken);
     getToken(scannerObj);
     
-    return returnNode;
+    return returnId;
   }
-  else if(scannerObj.scannerToken.tokenId == "INT_tk") //Case 3
+  else if(scannerObj.scannerToken.kind == INT_tk) //Case 3
   {
-    returnNode->tokens.push_back(scannerObj.scannerToken);
+    returnNode.addToken(scannerObj.scannerToken);
     getToken(scannerObj);
     
-    return returnNode;
+    return returnId;
   }
-  else handleError("(, identifer, or integer", scannerObj.scannerToken.instance, scannerObj.scannerToken.line);
+  else handleError("(, identifer, or integer", tokenText(scannerObj), scannerObj.scannerToken.line);
   
-  return returnNode;
+  return returnId;
 }
@@ -28,16 +28,28 @@
 #define PARSER_H
 
 #include <memory>
+#include <ostream>
 
 #include "tree.h"
+#include "scanner.h"
 
 
+//Which parser builds the tree. Both build the same tree and throw the same errors
+enum ParserBackend : uint8_t {
+  DESCENT_parse, //A function for every nonterminal in the BNF
+  TABLE_parse,   //A stack driven by the LL(1) parse table worked out from the BNF at compile time (grammar.h)
+  PARSERS        //How many backends there are
+};
+
+//The name of every ParserBackend as --parser= takes it, PARSER_NAMES[backend]
+extern const char* const PARSER_NAMES[PARSERS];
+
 /*
- * Auxiliary function for the parser. Opens the file passed by FILENAME
- * and calls the first nonterminal in the BNF. Catches any invalid_argument
- * errors thrown by the program. Returns NULL if a error was found when parsing
- * or returns the root of the parse tree.
+ * Auxiliary function for the parser. Scans the buffer scannerIn points at
+ * and parses it with BACKEND from the first nonterminal in the BNF. Catches any invalid_argument
+ * errors thrown by the program and prints them to diag. Returns NO_NODE if a error was found when parsing
+ * or returns the root of the parse tree. The nodes are allocated in tree.
  */
-std::unique_ptr<Node> parser(const std::string FILENAME);
+NodeId parser(ScannerIn &scannerIn, Tree &tree, std::ostream &diag, const ParserBackend BACKEND = DESCENT_parse);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include <iomanip>
+
+#include "peephole.h"
+
+/*
+ * One run of the rules over the target. Instructions are moved to out one at a time and the rules look at the
+ * end of out after every move, so a rewrite that exposes another pattern is caught right away.
+ */
+struct PeepholePass {
+  std::vector<AsmInstr> out;   //The rewritten target so far
+  std::vector<uint32_t> uses;  //How many branches go to each label
+  std::vector<uint32_t> alias; //The label each label was merged into, itself if it was not
+};
+
+//A rule of the peephole pass. apply rewrites the end of the pass and returns true if the rule fired
+struct PeepholeEntry {
+  const char* name;
+  bool (*apply)(PeepholePass& pass);
+};
+
+static bool storeLoad(PeepholePass& pass);
+static bool loadStore(PeepholePass& pass);
+static bool deadLoad(PeepholePass& pass);
+static bool doubleNeg(PeepholePass& pass);
+static bool identity(PeepholePass& pass);
+static bool branchNext(PeepholePass& pass);
+static bool unusedLabel(PeepholePass& pass);
+static bool labelChain(PeepholePass& pass);
+
+//The rules, PEEPHOLE_RULES[rule]. They are tried in this order after every instruction
+static const PeepholeEntry PEEPHOLE_RULES[PEEPHOLERULES] = {
+  { "store-load", storeLoad },     //STORE x LOAD x -> STORE x
+  { "load-store", loadStore },     //LOAD x STORE x -> LOAD x
+  { "dead-load", deadLoad },       //LOAD x LOAD y -> LOAD y
+  { "double-neg", doubleNeg },     //MULT -1 MULT -1 -> nothing, exact when the acc wraps
+  { "identity", identity },        //ADD 0 | SUB 0 | MULT 1 | DIV 1 -> nothing
+  { "branch-next", branchNext },   //BR* L followed by L: -> L:
+  { "unused-label", unusedLabel }, //L: NOOP with no branch to L -> nothing
+  { "label-chain", labelChain }    //L1: NOOP L2: NOOP -> L1: NOOP with every branch to L2 going to L1
+};
+
+static void runPass(std::vector<AsmInstr>& code, const uint32_t RULES, PeepholeReport& report, bool& fired);
+static uint32_t resolve(const PeepholePass& PASS, uint32_t label);
+static bool isLabel(const AsmInstr& INSTR);
+static bool isBranch(const AsmInstr& INSTR);
+static bool isInt(const AsmInstr& INSTR, const int32_t VALUE);
+static bool sameArg(const AsmInstr& A, const AsmInstr& B);
+
+/*
+ * Finds the rule called NAME, the names are the ones printed in the report.
+ * Is passed the name to look up and where to save the rule.
+ * Returns false if there is no rule called NAME.
+ */
+bool findPeepholeRule(const std::string_view NAME, PeepholeRule& rule)
+{
+  for(int i = 0; i < PEEPHOLERULES; i++)
+  {
+    if(NAME == PEEPHOLE_RULES[i].name)
+    {
+      rule = static_cast<PeepholeRule>(i);
+      return true;
+    }
+  }
+  
+  return false;
+}
+
+/*
+ * Description: Rewrites short runs of instructions of code into fewer ones with the rules turned on in RULES. The rules
+ *              are run over the whole target again until none of them fire. Every label is expected to be on a NOOP
+ *              and only branches refer to labels.
+ * Passed:      The target code, the rules to run and the report to count what fired in.
+ */
+void peephole(std::vector<AsmInstr>& code, const uint32_t RULES, PeepholeReport& report)
+{
+  report.before += code.size();
+  
+  bool fired = true;
+  while(fired)
+  {
+    runPass(code, RULES, report, fired);
+    report.passes++;
+  }
+  
+  report.after += code.size();
+}
+
+//Prints how many instructions were removed and how many times each rule fired to out
+void printReport(const PeepholeReport& REPORT, std::ostream& out)
+{
+  out << "Peephole: " << REPORT.before << " -> " << REPORT.after << " instructions in " << REPORT.passes << " passes" << std::endl;
+  for(int i = 0; i < PEEPHOLERULES; i++)
+  {
+    out << "  " << std::left << std::setw(14) << PEEPHOLE_RULES[i].name << std::right << REPORT.fired[i] << std::endl;
+  }
+}
+
+/*
+ * Description: Runs the rules turned on in RULES once over code. After every instruction the rules are tried on the
+ *              end of the rewritten target until none fire. Branches to merged labels are pointed at the label
+ *              they were merged into once the whole target is done.
+ * Passed:      The target code, the rules to run, the report to count in and fired which is set if any rule fired.
+ */
+static void runPass(std::vector<AsmInstr>& code, const uint32_t RULES, PeepholeReport& report, bool& fired)
+{
+  PeepholePass pass;
+  pass.out.reserve(code.size());
+  fired = false;
+  
+  //Count the branches to every label
+  uint32_t labels = 0;
+  for(const AsmInstr& instr : code)
+  {
+    if(isLabel(instr) && instr.label >= labels) labels = instr.label + 1;
+    if(isBranch(instr) && instr.arg >= labels) labels = instr.arg + 1;
+  }
+  pass.uses.assign(labels, 0);
+  pass.alias.resize(labels);
+  for(uint32_t i = 0; i < labels; i++) pass.alias[i] = i;
+  for(const AsmInstr& instr : code)
+  {
+    if(isBranch(instr)) pass.uses[instr.arg]++;
+  }
+  
+  for(const AsmInstr& instr : code)
+  {
+    pass.out.push_back(instr);
+    
+    //Keep rewriting the end until nothing matches
+    bool matched = true;
+    while(matched)
+    {
+      matched = false;
+      for(int rule = 0; rule < PEEPHOLERULES && !matched; rule++)
+      {
+        if((RULES & (1u << rule)) && PEEPHOLE_RULES[rule].apply(pass))
+        {
+          report.fired[rule]++;
+          matched = true;
+          fired = true;
+        }
+      }
+    }
+  }
+  
+  for(AsmInstr& instr : pass.out)
+  {
+    if(isBranch(instr)) instr.arg = resolve(pass, instr.arg);
+  }
+  code.swap(pass.out);
+}
+
+//STORE x LOAD x -> STORE x, the acc already holds x
+static bool storeLoad(PeepholePass& pass)
+{
+  size_t size = pass.out.size();
+  if(size < 2) return false;
+  const AsmInstr& first = pass.out[size - 2];
+  const AsmInstr& second = pass.out[size - 1];
+  if(first.op != STORE_op || second.op != LOAD_op || isLabel(second) || !sameArg(first, second)) return false;
+  
+  pass.out.pop_back();
+  return true;
+}
+
+//LOAD x STORE x -> LOAD x, x already holds the acc
+static bool loadStore(PeepholePass& pass)
+{
+  size_t size = pass.out.size();
+  if(size < 2) return false;
+  const AsmInstr& first = pass.out[size - 2];
+  const AsmInstr& second = pass.out[size - 1];
+  if(first.op != LOAD_op || second.op != STORE_op || isLabel(second) || !sameArg(first, second)) return false;
+  
+  pass.out.pop_back();
+  return true;
+}
+
+//LOAD x LOAD y -> LOAD y, nothing reads the first value
+static bool deadLoad(PeepholePass& pass)
+{
+  size_t size = pass.out.size();
+  if(size < 2) return false;
+  const AsmInstr& first = pass.out[size - 2];
+  const AsmInstr& second = pass.out[size - 1];
+  if(first.op != LOAD_op || second.op != LOAD_op || isLabel(first)) return false;
+  
+  pass.out[size - 2] = second;
+  pass.out.pop_back();
+  return true;
+}
+
+//MULT -1 MULT -1 -> nothing, -(-x) is x even for the smallest integer since the acc wraps
+static bool doubleNeg(PeepholePass& pass)
+{
+  size_t size = pass.out.size();
+  if(size < 2) return false;
+  const AsmInstr& first = pass.out[size - 2];
+  const AsmInstr& second = pass.out[size - 1];
+  if(first.op != MULT_op || second.op != MULT_op || !isInt(first, -1) || !isInt(second, -1)) return false;
+  if(isLabel(first) || isLabel(second)) return false;
+  
+  pass.out.resize(size - 2);
+  return true;
+}
+
+//ADD 0 | SUB 0 | MULT 1 | DIV 1 -> nothing, the acc does not change
+static bool identity(PeepholePass& pass)
+{
+  if(pass.out.empty()) return false;
+  const AsmInstr& last = pass.out.back();
+  if(isLabel(last)) return false;
+  
+  bool zero = (last.op == ADD_op || last.op == SUB_op) && isInt(last, 0);
+  bool one = (last.op == MULT_op || last.op == DIV_op) && isInt(last, 1);
+  if(!zero && !one) return false;
+  
+  pass.out.pop_back();
+  return true;
+}
+
+/*
+ * BR* L followed by L: -> L:, going to L and falling through to it are the same. The branch may be followed by
+ * any number of labels, it is removed if it goes to any of them. Branches do not change the acc so a conditional
+ * branch is removed the same as BR.
+ */
+static bool branchNext(PeepholePass& pass)
+{
+  if(pass.out.empty() || !isLabel(pass.out.back())) return false;
+  
+  //Find the instruction before the labels at the end
+  size_t branch = pass.out.size() - 1;
+  while(branch > 0 && isLabel(pass.out[branch]) && pass.out[branch].op == NOOP_op) branch--;
+  if(isLabel(pass.out[branch]) || !isBranch(pass.out[branch])) return false;
+  
+  uint32_t target = resolve(pass, pass.out[branch].arg);
+  for(size_t i = branch + 1; i < pass.out.size(); i++)
+  {
+    if(resolve(pass, pass.out[i].label) == target)
+    {
+      pass.uses[target]--;
+      pass.out.erase(pass.out.begin() + branch);
+      return true;
+    }
+  }
+  
+  return false;
+}
+
+//L: NOOP with no branch to L -> nothing, the NOOP would only take time to run
+static bool unusedLabel(PeepholePass& pass)
+{
+  if(pass.out.empty()) return false;
+  const AsmInstr& last = pass.out.back();
+  if(!isLabel(last) || last.op != NOOP_op || pass.uses[last.label] != 0) return false;
+  
+  pass.out.pop_back();
+  return true;
+}
+
+//L1: NOOP L2: NOOP -> L1: NOOP, every branch to L2 goes to L1 instead
+static bool labelChain(PeepholePass& pass)
+{
+  size_t size = pass.out.size();
+  if(size < 2) return false;
+  const AsmInstr& first = pass.out[size - 2];
+  const AsmInstr& second = pass.out[size - 1];
+  if(!isLabel(first) || !isLabel(second) || first.op != NOOP_op || second.op != NOOP_op) return false;
+  
+  pass.alias[second.label] = first.label;
+  pass.uses[first.label] += pass.uses[second.label];
+  pass.uses[second.label] = 0;
+  pass.out.pop_back();
+  return true;
+}
+
+//Returns the label that label was merged into
+static uint32_t resolve(const PeepholePass& PASS, uint32_t label)
+{
+  while(PASS.alias[label] != label) label = PASS.alias[label];
+  return label;
+}
+
+//Checks if a label is defined on INSTR
+static bool isLabel(const AsmInstr& INSTR)
+{
+  return INSTR.label != NO_LABEL;
+}
+
+//Checks if INSTR is BR or any of the conditional branches
+static bool isBranch(const AsmInstr& INSTR)
+{
+  return INSTR.op <= BRZERO_op;
+}
+
+//Checks if the argument of INSTR is the integer VALUE
+static bool isInt(const AsmInstr& INSTR, const int32_t VALUE)
+{
+  return INSTR.kind == INT_ak && INSTR.arg == static_cast<uint32_t>(VALUE);
+}
+
+//Checks if A and B have the same argument
+static bool sameArg(const AsmInstr& A, const AsmInstr& B)
+{
+  return A.kind == B.kind && A.arg == B.arg;
+}
\ No newline at end of file
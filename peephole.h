@@ -0,0 +1,45 @@
+#ifndef PEEPHOLE_H
+#define PEEPHOLE_H
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "asm.h"
+
+//Every rule of the peephole pass, see PEEPHOLE_RULES in peephole.cpp for what each one does
+enum PeepholeRule : uint8_t {
+  STORELOAD_ph, LOADSTORE_ph, DEADLOAD_ph, DOUBLENEG_ph, IDENTITY_ph, BRANCHNEXT_ph, UNUSEDLABEL_ph, LABELCHAIN_ph,
+  PEEPHOLERULES //How many rules there are
+};
+
+const uint32_t ALL_PEEPHOLE = (1u << PEEPHOLERULES) - 1; //Every rule turned on, bit 1 << rule per rule
+
+//What a peephole pass did
+struct PeepholeReport {
+  uint32_t fired[PEEPHOLERULES] = {}; //How many times each rule fired
+  size_t before = 0;                  //Instructions before the pass, labels are on a NOOP and count as one
+  size_t after = 0;                   //Instructions after the pass
+  int passes = 0;                     //Times the rules were run over the whole target
+};
+
+/*
+ * Finds the rule called NAME, the names are the ones printed in the report.
+ * Is passed the name to look up and where to save the rule.
+ * Returns false if there is no rule called NAME.
+ */
+bool findPeepholeRule(const std::string_view NAME, PeepholeRule& rule);
+
+/*
+ * Description: Rewrites short runs of instructions of code into fewer ones with the rules turned on in RULES. The rules
+ *              are run over the whole target again until none of them fire. Every label is expected to be on a NOOP
+ *              and only branches refer to labels.
+ * Passed:      The target code, the rules to run and the report to count what fired in.
+ */
+void peephole(std::vector<AsmInstr>& code, const uint32_t RULES, PeepholeReport& report);
+
+//Prints how many instructions were removed and how many times each rule fired to out
+void printReport(const PeepholeReport& REPORT, std::ostream& out);
+
+#endif
\ No newline at end of file
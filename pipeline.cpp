@@ -0,0 +1,133 @@
+#include <stdexcept>
+
+#include "pipeline.h"
+
+const size_t SPINS = 64; //Times a side looks at the other index again before it yields its core
+
+static void backOff(const size_t SPIN);
+
+
+TokenRing::TokenRing()
+  : slots(new Token[CAPACITY]), tail(0), headSeen(0), closed(false), stopped(false), head(0), tailSeen(0) {}
+
+/*
+ * Definition: Adds TOKEN to the ring, waits while it is full.
+ * Passed:     The token
+ * Returns:    False without adding it when the popper stopped the ring
+ */
+bool TokenRing::push(const Token& TOKEN)
+{
+  //Head is loaded with acquire so the popper is done reading a slot before it is written again
+  size_t tail = this->tail.load(std::memory_order_relaxed);
+  for(size_t spin = 0; tail - this->headSeen == CAPACITY; spin++)
+  {
+    this->headSeen = this->head.load(std::memory_order_acquire);
+    if(tail - this->headSeen != CAPACITY) break;
+    if(this->stopped.load(std::memory_order_relaxed)) return false;
+    backOff(spin);
+  }
+  
+  this->slots[tail & (CAPACITY - 1)] = TOKEN;
+  this->tail.store(tail + 1, std::memory_order_release);
+  return !this->stopped.load(std::memory_order_relaxed);
+}
+
+/*
+ * Definition: Takes the oldest token off the ring, waits while it is empty and open. Once the ring is closed and
+ *             empty throws the error it was closed with as a invalid_argument error, or hands out the last token
+ *             again when there is none.
+ * Returns:    The token
+ */
+Token TokenRing::pop()
+{
+  //Closed is loaded before tail so once it is set the tail loaded after it is the last one
+  size_t head = this->head.load(std::memory_order_relaxed);
+  for(size_t spin = 0; head == this->tailSeen; spin++)
+  {
+    bool closed = this->closed.load(std::memory_order_acquire);
+    this->tailSeen = this->tail.load(std::memory_order_acquire);
+    if(head != this->tailSeen) break;
+    if(closed && !this->error.empty()) throw std::invalid_argument(this->error);
+    if(closed) return this->last;
+    backOff(spin);
+  }
+  
+  this->last = this->slots[head & (CAPACITY - 1)];
+  this->head.store(head + 1, std::memory_order_release);
+  return this->last;
+}
+
+//Called by the pusher when it is done, ERROR is the message pop throws after the last token, empty if there is none
+void TokenRing::close(const std::string& ERROR)
+{
+  this->error = ERROR;
+  this->closed.store(true, std::memory_order_release);
+}
+
+//Called by the popper when it wants no more tokens, push fails from then on
+void TokenRing::stop()
+{
+  this->stopped.store(true, std::memory_order_relaxed);
+}
+
+/*
+ * Definition: Starts scanning on a thread from where scannerIn is and points scannerIn at the pipeline so scanner
+ *             hands out its tokens. scannerIn has to stay as long as the pipeline.
+ * Passed:     The scanner position in the input buffer
+ */
+ScanPipeline::ScanPipeline(ScannerIn& scannerIn) : producer(scannerIn)
+{
+  scannerIn.pipeline = this;
+  this->thread = std::thread(&ScanPipeline::produce, this);
+}
+
+//Stops the thread
+ScanPipeline::~ScanPipeline()
+{
+  this->stop();
+}
+
+/*
+ * Definition: Hands out the next token the thread scanned, waits for it when there is none yet.
+ *             Throws a invalid_argument error with the message of the scanner when it found a non valid token.
+ * Returns:    The token
+ */
+Token ScanPipeline::next()
+{
+  return this->ring.pop();
+}
+
+//Stops the thread and waits for it to finish, the symbol table is not written to after this
+void ScanPipeline::stop()
+{
+  if(!this->thread.joinable()) return;
+  
+  this->ring.stop();
+  this->thread.join();
+}
+
+//Loop of the thread. Scans up to EOF_tk, the first lexical error or until the pipeline is stopped
+void ScanPipeline::produce()
+{
+  std::string error;
+  try
+  {
+    Token token;
+    do
+    {
+      token = scanner(this->producer);
+    } while(this->ring.push(token) && token.kind != EOF_tk);
+  }
+  catch(const std::invalid_argument &e) //Lexical error, the parser thread throws it after the tokens before it
+  {
+    error = e.what();
+  }
+  
+  this->ring.close(error);
+}
+
+//Waits a moment for the other side of the ring, the first few times by looking again at once
+static void backOff(const size_t SPIN)
+{
+  if(SPIN >= SPINS) std::this_thread::yield();
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "language.h"
+#include "scanner.h"
+
+/*
+ * Bounded ring of tokens between one thread that pushes and one that pops, without locks. Each side owns one index
+ * and only reads the other, a token is written before tail is moved past it and read before head is. Each side keeps
+ * the last index it saw of the other and only loads it again when that one says the ring is full or empty. A side
+ * that has to wait spins a little and then yields, the pusher waits while the ring is full so the scanner never gets
+ * more than CAPACITY tokens ahead of the parser.
+ */
+class TokenRing
+{
+  private:
+    static const size_t CAPACITY = 1 << 12; //Tokens the ring holds, a power of two so the index wraps with a mask
+    static const size_t CACHE_LINE = 64;     //The two sides keep their indexes apart so they don't share a line
+    
+    std::unique_ptr<Token[]> slots;
+    alignas(CACHE_LINE) std::atomic<size_t> tail; //Next slot the pusher writes, only it moves tail
+    size_t headSeen;                              //Last head the pusher loaded
+    std::atomic<bool> closed;                     //Set once the pusher is done, nothing is pushed after it
+    std::atomic<bool> stopped;                    //Set when the popper wants no more tokens
+    std::string error;                            //Why the pusher closed, written before closed is set
+    alignas(CACHE_LINE) std::atomic<size_t> head; //Next slot the popper reads, only it moves head
+    size_t tailSeen;                              //Last tail the popper loaded
+    Token last;                                   //Last token popped, handed out again after a clean close
+    
+  public:
+    TokenRing();
+    
+    TokenRing(const TokenRing&) = delete;
+    TokenRing& operator=(const TokenRing&) = delete;
+    
+    /*
+     * Definition: Adds TOKEN to the ring, waits while it is full.
+     * Passed:     The token
+     * Returns:    False without adding it when the popper stopped the ring
+     */
+    bool push(const Token& TOKEN);
+    
+    /*
+     * Definition: Takes the oldest token off the ring, waits while it is empty and open. Once the ring is closed and
+     *             empty throws the error it was closed with as a invalid_argument error, or hands out the last token
+     *             again when there is none.
+     * Returns:    The token
+     */
+    Token pop();
+    
+    //Called by the pusher when it is done, ERROR is the message pop throws after the last token, empty if there is none
+    void close(const std::string& ERROR);
+    
+    //Called by the popper when it wants no more tokens, push fails from then on
+    void stop();
+};
+
+/*
+ * Scans a buffer on a thread of its own while the parser reads the tokens (scanner.h). The thread pushes every token
+ * into a ring and closes it with the lexical error the scanner threw, the parser thread gets the same tokens and the
+ * same error as scanning one token at a time. The thread interns into the symbol table of the scanner so the table is
+ * only read once it stopped, symbolText in scanner.h stops it first.
+ */
+class ScanPipeline
+{
+  private:
+    ScannerIn producer; //The scanner of the thread
+    TokenRing ring;
+    std::thread thread;
+    
+    void produce();
+    
+  public:
+    /*
+     * Definition: Starts scanning on a thread from where scannerIn is and points scannerIn at the pipeline so scanner
+     *             hands out its tokens. scannerIn has to stay as long as the pipeline.
+     * Passed:     The scanner position in the input buffer
+     */
+    ScanPipeline(ScannerIn& scannerIn);
+    
+    ScanPipeline(const ScanPipeline&) = delete;
+    ScanPipeline& operator=(const ScanPipeline&) = delete;
+    
+    //Stops the thread
+    ~ScanPipeline();
+    
+    /*
+     * Definition: Hands out the next token the thread scanned, waits for it when there is none yet.
+     *             Throws a invalid_argument error with the message of the scanner when it found a non valid token.
+     * Returns:    The token
+     */
+    Token next();
+    
+    //Stops the thread and waits for it to finish, the symbol table is not written to after this
+    void stop();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,297 @@
+//Writes programs for the stress tests and benchmarks of the makefile to cout, every program is the same each time it
+//is generated
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+const int VARIABLES = 8; //Variables the statements of a generated program use
+
+static void genStats(const size_t COUNT);
+static void genNest(const size_t DEPTH);
+static void genVars(const size_t COUNT);
+static void genFold(const size_t SEED);
+static void genFoldExp(std::mt19937& random, const int DEPTH);
+static void genStat(std::mt19937& random, size_t& count);
+static void genExp(std::mt19937& random, const int DEPTH);
+static std::string varName(const size_t I);
+static size_t parseCount(const std::string TEXT);
+static void exitError(const std::string S);
+
+
+int main(int argc, char *argv[]) 
+{
+  if(argc != 3) exitError("Usage: proggen stats COUNT | nest DEPTH | vars COUNT | fold SEED");
+  
+  std::ios::sync_with_stdio(false);
+  std::string mode = argv[1];
+  if(mode == "stats") genStats(parseCount(argv[2]));
+  else if(mode == "nest") genNest(parseCount(argv[2]));
+  else if(mode == "vars") genVars(parseCount(argv[2]));
+  else if(mode == "fold") genFold(parseCount(argv[2]));
+  else exitError("Unknown program " + mode);
+  
+  std::cout.flush();
+  return 0;
+}
+
+/*
+ *  Description: Writes a program of COUNT statements of every kind in one block, reading, printing, assigning and
+ *               testing a few variables. Some statements are blocks, conditions or loops holding a few more, each of
+ *               them counts as a statement too.
+ *  Passed: How many statements the program has.
+ */
+static void genStats(const size_t COUNT)
+{
+  std::mt19937 random(4280);
+  std::cout << "program\nvar";
+  for(int i = 0; i < VARIABLES; i++) std::cout << " " << varName(i) << " , " << i;
+  std::cout << " ;\nstart\n";
+  
+  size_t count = 0;
+  while(count < COUNT)
+  {
+    std::cout << "  ";
+    genStat(random, count);
+    std::cout << "\n";
+  }
+  std::cout << "stop\n";
+}
+
+/*
+ *  Description: Writes a program of blocks DEPTH deep, each block but the outermost inside a condition or loop of the
+ *               one around it. Every block declares a variable, works it out from the one of the block around it and
+ *               prints it after the blocks inside it.
+ *  Passed: How many blocks deep the program goes.
+ */
+static void genNest(const size_t DEPTH)
+{
+  std::cout << "program\nvar " << varName(0) << " , 1 ;\nstart\n";
+  for(size_t i = 1; i <= DEPTH; i++)
+  {
+    std::cout << (i % 2 == 0 ? "iff [ " : "iterate [ ") << varName(i - 1) << " .gt. 0 ] start var " << varName(i)
+              << " , 0 ; set " << varName(i) << " " << varName(i - 1) << " - 1 ;\n";
+  }
+  for(size_t i = DEPTH; i >= 1; i--) std::cout << "print " << varName(i) << " ; stop\n";
+  std::cout << "stop\n";
+}
+
+/*
+ *  Description: Writes a program declaring COUNT variables that prints each of them once, last declared first.
+ *  Passed: How many variables the program has.
+ */
+static void genVars(const size_t COUNT)
+{
+  std::cout << "program\nvar";
+  for(size_t i = 0; i < COUNT; i++) std::cout << (i % 8 == 0 ? "\n  " : " ") << varName(i) << " , " << i % 1000;
+  std::cout << " ;\nstart\n";
+  for(size_t i = COUNT; i >= 1; i--) std::cout << "  print " << varName(i - 1) << " ;\n";
+  std::cout << "stop\n";
+}
+
+/*
+ *  Description: Writes a program for make fold-check to compile with and without folding and run. It sets four
+ *               variables and reads them in a order that depends on SEED, a read without input keeps what was set.
+ *               Then it prints the edge cases of the target arithmetic: sums and products that wrap at 32 bits,
+ *               integers past 32 bits, division of negative numbers and every identity foldExpr removes. Then it
+ *               prints random expressions of the variables and integers near the edges, dividing mostly by numbers
+ *               that are not 0. Every program ends with a division that faults, by zero, in some of them behind x - x
+ *               or a % 0 whose other side still faults, or INT_MIN / -1.
+ *  Passed: The seed of the random numbers.
+ */
+static void genFold(const size_t SEED)
+{
+  static const char* const EDGES[] = {
+    "x0 / 1000 / - 1", "x1 / x1",
+    "2147483647 + 1", "- ( - 2147483647 - 1 )", "65536 % 65536", "46341 % 46341", "99999999 % 99999999 % 7",
+    "2147483648 - 1", "4294967296 + 1", "4294967295 % 3", "99999999999 / 7",
+    "- 7 / 2", "7 / - 2", "- 7 / - 2", "x2 / 1000",
+    "x0 + 0", "0 + x1", "x2 - 0", "0 - x3", "x0 - x0", "x1 % 1", "1 % x2", "x3 % - 1", "- 1 % x0", "x1 / 1",
+    "- - x2", "x3 + - x0", "x1 - - x2", "x0 % 0", "0 % x3", "0 % ( x1 + 5 )"
+  };
+  static const char* const FAULTS[] = { "x0 / 0", "7 / ( 5 - 5 )", "x1 / ( x2 - x2 )", "0 % ( x3 / 0 )",
+                                        "( x0 / 0 ) % 0", "x2 / ( x3 % 0 )", "( - 2147483647 - 1 ) / - 1",
+                                        "( - 2147483647 - 1 ) / ( 0 - 1 )", "( x1 - x1 - 2147483647 - 1 ) / - 1" };
+  
+  std::mt19937 random(SEED);
+  int order[4] = { 0, 1, 2, 3 };
+  for(int i = 3; i > 0; i--) std::swap(order[i], order[random() % (i + 1)]);
+  
+  //What is set before a read is what the variable keeps when the read gets no input
+  std::cout << "program\nvar x0 , 0 x1 , 0 x2 , 0 x3 , 0 ;\nstart\n";
+  for(int i = 0; i < 4; i++) std::cout << "  set x" << order[i] << " " << 1 + random() % 9 << " ;\n";
+  for(int i = 0; i < 4; i++) std::cout << "  read x" << order[i] << " ;\n";
+  for(const char* edge : EDGES) std::cout << "  print " << edge << " ;\n";
+  for(int i = 0; i < 40; i++)
+  {
+    std::cout << "  print ";
+    genFoldExp(random, 4);
+    std::cout << " ;\n";
+  }
+  std::cout << "  print " << FAULTS[SEED % 9] << " ;\n";
+  if(SEED % 3 == 0) std::cout << "  print x0 / 0 ;\n";
+  std::cout << "stop\n";
+}
+
+/*
+ *  Description: Writes a random expression for genFold of the four variables, small integers and integers near the
+ *               edges of 32 bits, INT_MIN as - 2147483647 - 1 and past them.
+ *  Passed: The random numbers to build it from and how many more operators can be nested in it.
+ */
+static void genFoldExp(std::mt19937& random, const int DEPTH)
+{
+  static const char* const OPERATORS[] = { " + ", " - ", " % " };
+  static const char* const EDGES[] = { "2147483647", "1073741824", "65536", "46341", "99999999", "2147483648",
+                                       "4294967295", "( - 2147483647 - 1 )" };
+  
+  uint32_t pick = random() % 20;
+  if(DEPTH == 0 || pick < 8)
+  {
+    uint32_t leaf = random() % 20;
+    if(leaf < 8) std::cout << "x" << leaf % 4;
+    else if(leaf < 16) std::cout << leaf - 8;
+    else std::cout << EDGES[random() % 8];
+    return;
+  }
+  
+  if(pick < 10)
+  {
+    std::cout << "( ";
+    genFoldExp(random, DEPTH - 1);
+    std::cout << " )";
+  }
+  else if(pick < 12)
+  {
+    std::cout << "- ";
+    genFoldExp(random, DEPTH - 1);
+  }
+  else if(pick < 19)
+  {
+    genFoldExp(random, DEPTH - 1);
+    std::cout << OPERATORS[pick % 3];
+    genFoldExp(random, DEPTH - 1);
+  }
+  //Mostly divides by a variable or integer that is not 0 so a program gets far before it divides by zero
+  else
+  {
+    genFoldExp(random, DEPTH - 1);
+    std::cout << " / ";
+    static const char* const DIVISORS[] = { "x0", "x1", "x2", "x3", "- 1", "3", "65536" };
+    uint32_t divisor = random() % 16;
+    if(divisor == 15) genFoldExp(random, DEPTH - 1);
+    else std::cout << DIVISORS[divisor % 7];
+  }
+}
+
+/*
+ *  Description: Writes one random statement and adds how many statements it has to count.
+ *  Passed: The random numbers to build it from and the count of statements written so far.
+ */
+static void genStat(std::mt19937& random, size_t& count)
+{
+  count++;
+  std::string var = varName(random() % VARIABLES);
+  switch(random() % 10)
+  {
+    case 0:
+      std::cout << "read " << var << " ;";
+      break;
+    case 1:
+      std::cout << "print ";
+      genExp(random, 2);
+      std::cout << " ;";
+      break;
+    case 2:
+      std::cout << "start ";
+      for(int i = 0; i < 3; i++)
+      {
+        genStat(random, count);
+        std::cout << " ";
+      }
+      std::cout << "stop";
+      break;
+    case 3:
+    case 4:
+      std::cout << (random() % 2 == 0 ? "iff [ " : "iterate [ ") << var << " .lt. ";
+      genExp(random, 1);
+      std::cout << " ] ";
+      genStat(random, count);
+      break;
+    default:
+      std::cout << "set " << var << " ";
+      genExp(random, 3);
+      std::cout << " ;";
+  }
+}
+
+/*
+ *  Description: Writes a random expression of every operator, variables and integers.
+ *  Passed: The random numbers to build it from and how many more operators can be nested in it.
+ */
+static void genExp(std::mt19937& random, const int DEPTH)
+{
+  static const char* const OPERATORS[] = { " + ", " - ", " % ", " / " };
+  
+  uint32_t pick = random() % 8;
+  if(DEPTH == 0 || pick < 3)
+  {
+    if(pick % 2 == 0) std::cout << varName(random() % VARIABLES);
+    else std::cout << 1 + random() % 1000;
+    return;
+  }
+  
+  if(pick == 3)
+  {
+    std::cout << "( ";
+    genExp(random, DEPTH - 1);
+    std::cout << " )";
+    return;
+  }
+  
+  if(pick == 4) std::cout << "- ";
+  genExp(random, DEPTH - 1);
+  std::cout << OPERATORS[pick % 4];
+  genExp(random, DEPTH - 1);
+}
+
+//Returns the name of variable I, x and its number in base 36 so it stays in 8 characters and is never a keyword
+static std::string varName(const size_t I)
+{
+  std::string digits;
+  size_t i = I;
+  do
+  {
+    digits.insert(digits.begin(), "0123456789abcdefghijklmnopqrstuvwxyz"[i % 36]);
+    i /= 36;
+  } while(i != 0);
+  
+  return "x" + digits;
+}
+
+/*
+ *  Description: Reads a count like the COUNT of proggen stats COUNT. Exits if TEXT is not a number.
+ *  Passed: The TEXT of the count.
+ *  Return: The count.
+ */
+static size_t parseCount(const std::string TEXT)
+{
+  size_t count = 0;
+  if(TEXT.empty() || TEXT.size() > 9 || TEXT.find_first_not_of("0123456789") != std::string::npos)
+    exitError("Bad count " + TEXT);
+  for(char digit : TEXT) count = count * 10 + (digit - '0');
+  
+  return count;
+}
+
+/*
+ *  Description: Helper function that exits the program on an error.
+ *  Passed: Is passed a string to print.
+ *  Return: Exits the program
+ */
+static void exitError(const std::string S) 
+{
+  std::cout << S << std::endl;
+  exit(1);
+}
\ No newline at end of file
@@ -0,0 +1,515 @@
+#include <algorithm>
+#include <cctype>
+#include <utility>
+#include <vector>
+
+#include "propagate.h"
+
+const char TAKES_TARGET = 1;           //A block can go to its target
+const char TAKES_OTHER = 2;            //A block can go to its other block
+const uint32_t NO_BIT = UINT32_MAX;    //Live bit of a variable nothing sets
+const size_t MAX_LIVE_WORDS = 1 << 22; //Most words the variables live where every block starts can take, 32MB
+
+//What a variable is known to hold where a block starts or ends
+struct Fact {
+  uint32_t var; //Symbol ID of the variable
+  IrArg value;  //The integer it holds or the variable it is a copy of
+};
+
+typedef std::vector<Fact> Facts; //Sorted by variable, a variable that is not in it could hold anything
+
+/*
+ * Object for the program being propagated through to be passed throughout the pass.
+ */
+struct PropagateObj {
+  IrProgram &program;                                        //The program
+  const SymbolTable &symbols;                                //Symbols of the program
+  std::vector<std::vector<std::pair<uint32_t, char>>> preds; //Blocks that go to every block and which way they go
+  Facts entry;                                               //What the variables something sets start the program with
+  std::vector<Facts> out;                                    //What is known where every block ends
+  std::vector<char> takes;                                   //Ways every block can go, TAKES_TARGET and TAKES_OTHER
+  std::vector<char> visited;                                 //If every block has been worked through
+  std::vector<IrArg> value;                                  //What every variable holds, NONE_ia if unknown
+  std::vector<uint32_t> copies;                              //How many variables are a copy of every variable
+  std::vector<char> listed;                                  //If every variable is in known
+  std::vector<uint32_t> known;                               //Variables set in value since the block started
+  std::vector<IrArg> tempValue;                              //Integer every temp holds, NONE_ia if unknown
+};
+
+static std::vector<uint32_t> reversePostOrder(const IrProgram& PROGRAM);
+static bool blockIn(const PropagateObj& PROPOBJ, const uint32_t BLOCK, Facts& in);
+static void meet(Facts& facts, const Facts& OTHER);
+static bool sameFacts(const Facts& A, const Facts& B);
+static bool propagateBlock(PropagateObj& propObj, const uint32_t BLOCK, PropagateReport* report, Facts& facts,
+                           char& takes);
+static void substitute(const PropagateObj& PROPOBJ, IrArg& arg, PropagateReport* report);
+static bool fold(IrInstr& instr);
+static void setVar(PropagateObj& propObj, const uint32_t VAR, const IrArg VALUE);
+static bool isVariable(const IrArg& ARG, const SymbolTable& SYMBOLS);
+static void removeDeadAssignments(IrProgram& program, const size_t SYMBOLS, PropagateReport& report);
+static void liveThrough(IrBlock& block, const std::vector<uint32_t>& BITS, std::vector<uint64_t>& live,
+                        PropagateReport* report);
+static void liveOut(const IrProgram& PROGRAM, const uint32_t BLOCK, const std::vector<uint64_t>& LIVE_IN,
+                    std::vector<uint64_t>& live);
+static void addLive(const std::vector<uint32_t>& BITS, const IrArg& ARG, std::vector<uint64_t>& live);
+
+/*
+ * Description: Works out what every variable holds at every point of PROGRAM and uses it:
+ *              - a read of a variable known to hold a integer is replaced by the integer. Variables start with
+ *                the value they were declared with (var x , 5 ;), a value too big for 32 bits is not known.
+ *              - a read of a variable known to be a copy of another is replaced by that variable.
+ *              - a instruction whose operands are all integers becomes a copy of its result, x + 0, x % 1 and
+ *                alike become a copy of x. A division that could fault is kept.
+ *              - a assignment to a variable that is always set again or never read after it is removed.
+ *              What is known is carried along every way control can go and kept where the ways join only if
+ *              every way agrees. A read instruction makes its variable unknown. A branch whose test is known
+ *              only carries to the block it goes to, simplifyCfg (cfg.h) folds it afterwards.
+ * Passed:      The program, its semantic table and the report to count what was done in.
+ */
+void propagateConstants(IrProgram& program, SemanticTable& table, PropagateReport& report)
+{
+  const SymbolTable& symbols = table.symbolTable();
+  size_t blocks = program.blocks.size();
+  PropagateObj propObj = { program, symbols, std::vector<std::vector<std::pair<uint32_t, char>>>(blocks), Facts(),
+                           std::vector<Facts>(blocks), std::vector<char>(blocks, 0), std::vector<char>(blocks, false),
+                           std::vector<IrArg>(symbols.size(), noArg()), std::vector<uint32_t>(symbols.size(), 0),
+                           std::vector<char>(symbols.size(), false), std::vector<uint32_t>(),
+                           std::vector<IrArg>(program.temps, noArg()) };
+  
+  //Variables nothing sets hold their start value everywhere, they are filled in once instead of carried along
+  std::vector<char> set(symbols.size(), false);
+  for(const IrBlock& block : program.blocks)
+  {
+    for(const IrInstr& instr : block.instrs)
+    {
+      if(instr.dest.kind == SYMBOL_ia) set[instr.dest.id] = true;
+    }
+  }
+  for(uint32_t var = 0; var < symbols.size(); var++)
+  {
+    int32_t start;
+    if(!table.startValue(var, start)) continue;
+    
+    if(set[var]) propObj.entry.push_back({ var, intArg(start) });
+    else propObj.value[var] = intArg(start);
+  }
+  
+  for(uint32_t i = 0; i < blocks; i++)
+  {
+    const IrBlock& block = program.blocks[i];
+    if(block.term != STOP_tm) propObj.preds[block.target].emplace_back(i, TAKES_TARGET);
+    if(block.term == CBR_tm) propObj.preds[block.other].emplace_back(i, TAKES_OTHER);
+  }
+  
+  //Work through the blocks until what is known where they end stops changing. It only ever shrinks so this ends.
+  //A block is only worked through again when what is known where a block going to it ends changed
+  std::vector<uint32_t> order = reversePostOrder(program);
+  std::vector<char> dirty(blocks, true);
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+    for(uint32_t block : order)
+    {
+      Facts out;
+      char takes;
+      if(!dirty[block]) continue;
+      dirty[block] = false;
+      if(!propagateBlock(propObj, block, nullptr, out, takes)) continue; //Nothing that goes to it has been reached
+      if(propObj.visited[block] && takes == propObj.takes[block] && sameFacts(out, propObj.out[block])) continue;
+      
+      propObj.visited[block] = true;
+      propObj.takes[block] = takes;
+      propObj.out[block] = std::move(out);
+      if(program.blocks[block].term != STOP_tm) dirty[program.blocks[block].target] = true;
+      if(program.blocks[block].term == CBR_tm) dirty[program.blocks[block].other] = true;
+      changed = true;
+    }
+  }
+  
+  //Use what is known, blocks that were never reached are left for simplifyCfg to remove
+  Facts out;
+  char takes;
+  for(uint32_t block : order)
+  {
+    if(propObj.visited[block]) propagateBlock(propObj, block, &report, out, takes);
+  }
+  
+  removeDeadAssignments(program, symbols.size(), report);
+}
+
+//Prints what propagateConstants did to out
+void printReport(const PropagateReport& REPORT, std::ostream& out)
+{
+  out << "Propagation:" << std::endl;
+  out << "  constants          " << REPORT.constants << std::endl;
+  out << "  copies             " << REPORT.copies << std::endl;
+  out << "  folded             " << REPORT.folded << std::endl;
+  out << "  dead assignments   " << REPORT.deadAssignments << std::endl;
+}
+
+//Returns the blocks that can be reached from block 0 in reverse post order
+static std::vector<uint32_t> reversePostOrder(const IrProgram& PROGRAM)
+{
+  std::vector<uint32_t> order;
+  std::vector<char> seen(PROGRAM.blocks.size(), false);
+  std::vector<std::pair<uint32_t, char>> stack(1, { 0, 0 }); //Block and how many of its ways have been followed
+  seen[0] = true;
+  while(!stack.empty())
+  {
+    std::pair<uint32_t, char>& top = stack.back();
+    const IrBlock& block = PROGRAM.blocks[top.first];
+    char ways = block.term == STOP_tm ? 0 : block.term == JUMP_tm ? 1 : 2;
+    if(top.second == ways)
+    {
+      order.push_back(top.first);
+      stack.pop_back();
+      continue;
+    }
+    
+    uint32_t next = top.second++ == 0 ? block.target : block.other;
+    if(!seen[next])
+    {
+      seen[next] = true;
+      stack.emplace_back(next, 0);
+    }
+  }
+  
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+/*
+ * Description: Works out what is known where BLOCK starts from what is known where the reached blocks that go to it
+ *              end. Block 0 also starts the program.
+ * Passed:      The pass object, the block and where to save what is known.
+ * Returns:     False if nothing that goes to the block has been reached yet.
+ */
+static bool blockIn(const PropagateObj& PROPOBJ, const uint32_t BLOCK, Facts& in)
+{
+  bool reached = BLOCK == 0;
+  if(reached) in = PROPOBJ.entry;
+  for(const std::pair<uint32_t, char>& pred : PROPOBJ.preds[BLOCK])
+  {
+    if(!PROPOBJ.visited[pred.first] || (PROPOBJ.takes[pred.first] & pred.second) == 0) continue;
+    
+    if(reached) meet(in, PROPOBJ.out[pred.first]);
+    else in = PROPOBJ.out[pred.first];
+    reached = true;
+  }
+  
+  return reached;
+}
+
+//Keeps only the facts that OTHER knows too
+static void meet(Facts& facts, const Facts& OTHER)
+{
+  size_t kept = 0;
+  size_t j = 0;
+  for(size_t i = 0; i < facts.size(); i++)
+  {
+    while(j < OTHER.size() && OTHER[j].var < facts[i].var) j++;
+    if(j < OTHER.size() && OTHER[j].var == facts[i].var && OTHER[j].value == facts[i].value) facts[kept++] = facts[i];
+  }
+  facts.resize(kept);
+}
+
+//Checks if A and B know the same
+static bool sameFacts(const Facts& A, const Facts& B)
+{
+  if(A.size() != B.size()) return false;
+  
+  for(size_t i = 0; i < A.size(); i++)
+  {
+    if(A[i].var != B[i].var || A[i].value != B[i].value) return false;
+  }
+  return true;
+}
+
+/*
+ * Description: Works out what is known where BLOCK ends from what is known where it starts. With a report every
+ *              read of something known is replaced and every instruction that can be worked out is, and counted.
+ * Passed:      The pass object, the block, the report or null to leave the block as it is, where to save what is
+ *              known where the block ends and where to save which ways the block can go.
+ * Returns:     False if nothing that goes to the block has been reached yet.
+ */
+static bool propagateBlock(PropagateObj& propObj, const uint32_t BLOCK, PropagateReport* report, Facts& facts,
+                           char& takes)
+{
+  takes = 0;
+  if(!blockIn(propObj, BLOCK, facts)) return false;
+  size_t loaded = facts.size();
+  for(const Fact& fact : facts)
+  {
+    propObj.value[fact.var] = fact.value;
+    if(fact.value.kind == SYMBOL_ia) propObj.copies[fact.value.id]++;
+    propObj.listed[fact.var] = true;
+    propObj.known.push_back(fact.var);
+  }
+  
+  IrBlock& block = propObj.program.blocks[BLOCK];
+  for(IrInstr& original : block.instrs)
+  {
+    IrInstr instr = original;
+    substitute(propObj, instr.a, report);
+    substitute(propObj, instr.b, report);
+    if(fold(instr) && report != nullptr) report->folded++;
+    
+    bool copiesInt = instr.op == COPY_ir && instr.a.kind == INT_ia;
+    if(instr.dest.kind == TEMP_ia)
+    {
+      propObj.tempValue[instr.dest.id] = copiesInt ? instr.a : noArg();
+    }
+    else if(instr.dest.kind == SYMBOL_ia)
+    {
+      bool copiesVar = instr.op == COPY_ir && isVariable(instr.a, propObj.symbols) && instr.a != instr.dest;
+      setVar(propObj, instr.dest.id, copiesInt || copiesVar ? instr.a : noArg());
+    }
+    
+    if(report != nullptr) original = instr;
+  }
+  
+  if(block.term == JUMP_tm) takes = TAKES_TARGET;
+  if(block.term == CBR_tm)
+  {
+    IrArg a = block.a;
+    IrArg b = block.b;
+    substitute(propObj, a, report);
+    substitute(propObj, b, report);
+    
+    //Like foldBranches (cfg.h) a test of two integers or of something against itself is known
+    if(a.kind == INT_ia && b.kind == INT_ia)
+      takes = testHolds(block.rel, static_cast<int32_t>(a.id - b.id)) ? TAKES_TARGET : TAKES_OTHER;
+    else if(a == b)
+      takes = testHolds(block.rel, 0) ? TAKES_TARGET : TAKES_OTHER;
+    else
+      takes = TAKES_TARGET | TAKES_OTHER;
+    
+    if(report != nullptr)
+    {
+      block.a = a;
+      block.b = b;
+    }
+  }
+  
+  //What is known where the block ends, value is cleared for the next block. known starts with the variables known
+  //where the block started in order, only the ones set after them need sorting
+  size_t sorted = 0;
+  facts.clear();
+  for(size_t i = 0; i < propObj.known.size(); i++)
+  {
+    uint32_t var = propObj.known[i];
+    IrArg& value = propObj.value[var];
+    if(value.kind == SYMBOL_ia) propObj.copies[value.id]--;
+    if(value.kind != NONE_ia) facts.push_back({ var, value });
+    if(i < loaded) sorted = facts.size();
+    value = noArg();
+    propObj.listed[var] = false;
+  }
+  propObj.known.clear();
+  auto byVar = [](const Fact& A, const Fact& B) { return A.var < B.var; };
+  std::sort(facts.begin() + sorted, facts.end(), byVar);
+  std::inplace_merge(facts.begin(), facts.begin() + sorted, facts.end(), byVar);
+  
+  return true;
+}
+
+//Replaces ARG with what it is known to hold, counted in report if it is not null
+static void substitute(const PropagateObj& PROPOBJ, IrArg& arg, PropagateReport* report)
+{
+  IrArg value = noArg();
+  if(arg.kind == SYMBOL_ia) value = PROPOBJ.value[arg.id];
+  else if(arg.kind == TEMP_ia) value = PROPOBJ.tempValue[arg.id];
+  if(value.kind == NONE_ia) return;
+  
+  arg = value;
+  if(report != nullptr && value.kind == INT_ia) report->constants++;
+  else if(report != nullptr) report->copies++;
+}
+
+/*
+ * Description: Turns instr into a copy of its result if its operands are integers, wrapping around like the target,
+ *              or into a copy of one operand when the other does nothing to it (x + 0, x - 0, x % 1, x / 1). x % 0 is
+ *              a copy of 0. A division that could fault is left.
+ * Passed:      The instruction.
+ * Returns:     True if it was changed.
+ */
+static bool fold(IrInstr& instr)
+{
+  IrArg a = instr.a;
+  IrArg b = instr.b;
+  IrArg result = noArg();
+  if(instr.op == NEG_ir && a.kind == INT_ia)
+  {
+    result = intArg(static_cast<int32_t>(0u - a.id));
+  }
+  else if(a.kind == INT_ia && b.kind == INT_ia)
+  {
+    if(instr.op == ADD_ir) result = intArg(static_cast<int32_t>(a.id + b.id));
+    if(instr.op == SUB_ir) result = intArg(static_cast<int32_t>(a.id - b.id));
+    if(instr.op == MULT_ir) result = intArg(static_cast<int32_t>(a.id * b.id));
+    if(instr.op == DIV_ir && !canFault(instr)) result = intArg(static_cast<int32_t>(a.id) / static_cast<int32_t>(b.id));
+  }
+  else if(instr.op == ADD_ir)
+  {
+    if(b == intArg(0)) result = a; // x + 0
+    if(a == intArg(0)) result = b; // 0 + x
+  }
+  else if(instr.op == SUB_ir)
+  {
+    if(b == intArg(0)) result = a; // x - 0
+  }
+  else if(instr.op == MULT_ir)
+  {
+    if(b == intArg(1)) result = a;                            // x % 1
+    if(a == intArg(1)) result = b;                            // 1 % x
+    if(a == intArg(0) || b == intArg(0)) result = intArg(0); // x % 0
+  }
+  else if(instr.op == DIV_ir)
+  {
+    if(b == intArg(1)) result = a; // x / 1
+  }
+  if(result.kind == NONE_ia) return false;
+  
+  instr = { COPY_ir, instr.dest, result, noArg(), instr.line };
+  return true;
+}
+
+//Sets what VAR holds to VALUE, every variable that was a copy of it no longer is
+static void setVar(PropagateObj& propObj, const uint32_t VAR, const IrArg VALUE)
+{
+  IrArg& value = propObj.value[VAR];
+  if(value.kind == SYMBOL_ia) propObj.copies[value.id]--;
+  
+  for(size_t i = 0; propObj.copies[VAR] > 0 && i < propObj.known.size(); i++)
+  {
+    IrArg& copy = propObj.value[propObj.known[i]];
+    if(copy.kind != SYMBOL_ia || copy.id != VAR) continue;
+    
+    copy = noArg();
+    propObj.copies[VAR]--;
+  }
+  
+  value = VALUE;
+  if(VALUE.kind == SYMBOL_ia) propObj.copies[VALUE.id]++;
+  if(!propObj.listed[VAR])
+  {
+    propObj.listed[VAR] = true;
+    propObj.known.push_back(VAR);
+  }
+}
+
+//Checks if ARG is a variable and not a integer too big for 32 bits
+static bool isVariable(const IrArg& ARG, const SymbolTable& SYMBOLS)
+{
+  return ARG.kind == SYMBOL_ia && !isdigit(static_cast<unsigned char>(SYMBOLS.text(ARG.id)[0]));
+}
+
+/*
+ * Description: Removes every assignment to a variable that is set again or never read on every way on from it and
+ *              every copy of a variable to itself. A assignment only counts as reading its operands if it is kept,
+ *              so assignments that only feed each other go too. Reading a variable still happens since it takes
+ *              input and a division that could fault is kept. A program whose blocks times set variables needs
+ *              more than MAX_LIVE_WORDS words is left to simplifyCfg (cfg.h).
+ * Passed:      The program, how many symbols there are and the report to count in.
+ */
+static void removeDeadAssignments(IrProgram& program, const size_t SYMBOLS, PropagateReport& report)
+{
+  //Only a variable something sets can have a dead assignment, every one of them gets a bit
+  std::vector<uint32_t> bits(SYMBOLS, NO_BIT);
+  uint32_t vars = 0;
+  for(const IrBlock& block : program.blocks)
+  {
+    for(const IrInstr& instr : block.instrs)
+    {
+      if(instr.dest.kind == SYMBOL_ia && bits[instr.dest.id] == NO_BIT) bits[instr.dest.id] = vars++;
+    }
+  }
+  size_t words = (vars + 63) / 64;
+  size_t blocks = program.blocks.size();
+  if(vars == 0 || words * blocks > MAX_LIVE_WORDS) return;
+  
+  //Variables live where every block starts, worked out backwards until nothing changes. They only ever grow
+  std::vector<uint64_t> liveIn(words * blocks, 0);
+  std::vector<uint64_t> live(words);
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+    for(uint32_t i = blocks; i-- > 0;)
+    {
+      liveOut(program, i, liveIn, live);
+      liveThrough(program.blocks[i], bits, live, nullptr);
+      if(std::equal(live.begin(), live.end(), liveIn.begin() + i * words)) continue;
+      
+      std::copy(live.begin(), live.end(), liveIn.begin() + i * words);
+      changed = true;
+    }
+  }
+  
+  for(uint32_t i = 0; i < blocks; i++)
+  {
+    liveOut(program, i, liveIn, live);
+    liveThrough(program.blocks[i], bits, live, &report);
+  }
+}
+
+/*
+ * Description: Works backwards through block from the variables live where it ends to those live where it starts.
+ *              With a report every dead assignment is removed and counted. A read does not end its variable's life.
+ * Passed:      The block, the bit of every variable, the variables live where it ends and the report or null to
+ *              leave the block as it is.
+ */
+static void liveThrough(IrBlock& block, const std::vector<uint32_t>& BITS, std::vector<uint64_t>& live,
+                        PropagateReport* report)
+{
+  if(block.term == CBR_tm)
+  {
+    addLive(BITS, block.a, live);
+    addLive(BITS, block.b, live);
+  }
+  
+  size_t kept = block.instrs.size();
+  for(size_t i = block.instrs.size(); i-- > 0;)
+  {
+    const IrInstr instr = block.instrs[i];
+    if(instr.dest.kind == SYMBOL_ia)
+    {
+      uint32_t bit = BITS[instr.dest.id];
+      bool used = (live[bit / 64] >> (bit % 64) & 1) && !(instr.op == COPY_ir && instr.a == instr.dest);
+      if(!used && instr.op != READ_ir && !canFault(instr))
+      {
+        if(report != nullptr) report->deadAssignments++;
+        continue;
+      }
+      //A read that gets no input keeps the value it had, so what was stored before it stays live
+      if(instr.op != READ_ir) live[bit / 64] &= ~(1ull << (bit % 64));
+    }
+    addLive(BITS, instr.a, live);
+    addLive(BITS, instr.b, live);
+    
+    //Kept instructions are moved to the end of the block as they are found
+    if(report != nullptr) block.instrs[--kept] = instr;
+  }
+  
+  if(report != nullptr) block.instrs.erase(block.instrs.begin(), block.instrs.begin() + kept);
+}
+
+//Sets live to the variables live where BLOCK ends, those live where the blocks it goes to start
+static void liveOut(const IrProgram& PROGRAM, const uint32_t BLOCK, const std::vector<uint64_t>& LIVE_IN,
+                    std::vector<uint64_t>& live)
+{
+  const IrBlock& block = PROGRAM.blocks[BLOCK];
+  size_t words = live.size();
+  std::fill(live.begin(), live.end(), 0);
+  for(size_t w = 0; block.term != STOP_tm && w < words; w++) live[w] |= LIVE_IN[block.target * words + w];
+  for(size_t w = 0; block.term == CBR_tm && w < words; w++) live[w] |= LIVE_IN[block.other * words + w];
+}
+
+//Makes ARG live if it is a variable something sets
+static void addLive(const std::vector<uint32_t>& BITS, const IrArg& ARG, std::vector<uint64_t>& live)
+{
+  if(ARG.kind != SYMBOL_ia || BITS[ARG.id] == NO_BIT) return;
+  
+  live[BITS[ARG.id] / 64] |= 1ull << (BITS[ARG.id] % 64);
+}
\ No newline at end of file
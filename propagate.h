@@ -0,0 +1,36 @@
+#ifndef PROPAGATE_H
+#define PROPAGATE_H
+
+#include <cstdint>
+#include <ostream>
+
+#include "ir.h"
+#include "statSem.h"
+
+//What propagateConstants did
+struct PropagateReport {
+  uint32_t constants = 0;       //Reads replaced by the integer the variable or temp is known to hold
+  uint32_t copies = 0;          //Reads of a variable replaced by the variable it was copied from
+  uint32_t folded = 0;          //Instructions worked out at compile time
+  uint32_t deadAssignments = 0; //Assignments removed since what they set is set again or never read after them
+};
+
+/*
+ * Description: Works out what every variable holds at every point of PROGRAM and uses it:
+ *              - a read of a variable known to hold a integer is replaced by the integer. Variables start with
+ *                the value they were declared with (var x , 5 ;), a value too big for 32 bits is not known.
+ *              - a read of a variable known to be a copy of another is replaced by that variable.
+ *              - a instruction whose operands are all integers becomes a copy of its result, x + 0, x % 1 and
+ *                alike become a copy of x. A division that could fault is kept.
+ *              - a assignment to a variable that is always set again or never read after it is removed.
+ *              What is known is carried along every way control can go and kept where the ways join only if
+ *              every way agrees. A read instruction makes its variable unknown. A branch whose test is known
+ *              only carries to the block it goes to, simplifyCfg (cfg.h) folds it afterwards.
+ * Passed:      The program, its semantic table and the report to count what was done in.
+ */
+void propagateConstants(IrProgram& program, SemanticTable& table, PropagateReport& report);
+
+//Prints what propagateConstants did to out
+void printReport(const PropagateReport& REPORT, std::ostream& out);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,348 @@
+//Checks the scanner backends (scanner.h), skip kernels (skip.h), chunked scanning (lexer.h) and the pipeline
+//(pipeline.h) build the same tokens and times them, then checks the parser backends (parser.h) build the same tree
+//with the tokens as they are scanned and from the pipeline and times them, run by make scan-bench. With --check it
+//only checks, each program as it is and padded big enough to be scanned in chunks, run by make lex-check
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "source.h"
+#include "scanner.h"
+#include "symbols.h"
+#include "lexer.h"
+#include "pipeline.h"
+#include "parser.h"
+#include "tree.h"
+
+const int REPEATS = 200;          //Times every program is scanned by each setup
+const size_t CHUNK_THREADS = 4;   //Threads the chunked setups scan on
+const size_t PAD_BYTES = 1 << 19; //Spaces a checked program is padded with, enough for lexChunks to use every thread
+
+//A scanner backend, the level of the skip kernels it runs with, how many threads it scans in chunks on and if it
+//scans on a thread of its own
+struct ScanSetup {
+  ScannerBackend backend;
+  SkipLevel skip;
+  size_t threads; //1 scans one token at a time as the parser does
+  bool pipelined; //Scans on a thread of its own while the tokens are read (pipeline.h)
+};
+
+//A parser backend and the scanner setup it reads the tokens from
+struct ParseSetup {
+  ScanSetup scan;
+  ParserBackend parser;
+};
+
+static bool checkSame(const std::string NAME, const std::string& SOURCE, const std::vector<ScanSetup>& SETUPS,
+                      const ParseSetup* PARSESETUPS, const size_t PARSECOUNT);
+static std::string padLines(const std::string& SOURCE);
+static std::string scanAll(const std::string& SOURCE, const ScanSetup SETUP);
+static size_t countTokens(const std::string& SOURCE, const ScanSetup SETUP);
+static std::string parseAll(const std::string& SOURCE, const ParseSetup SETUP);
+static size_t countNodes(const std::string& SOURCE, const ParseSetup SETUP);
+static void startScan(ScannerIn &scannerIn, TokenStream &stream, std::unique_ptr<ScanPipeline> &pipeline,
+                      const std::string& SOURCE, const ScanSetup SETUP);
+static void report(const std::string NAME, const size_t TOKENS, const std::chrono::duration<double> SECONDS);
+static std::string setupName(const ScanSetup SETUP);
+static std::string setupName(const ParseSetup SETUP);
+static void exitError(const std::string S);
+
+
+int main(int argc, char *argv[]) 
+{
+  if(argc < 2) exitError("Usage: scanbench [--check] file.4280fs24...");
+  
+  bool checkOnly = std::string(argv[1]) == "--check";
+  int first = checkOnly ? 2 : 1;
+  if(first == argc) exitError("Usage: scanbench [--check] file.4280fs24...");
+  std::vector<std::string> programs;
+  for(int i = first; i < argc; i++)
+  {
+    try
+    {
+      SourceBuffer source(argv[i]);
+      programs.emplace_back(source.begin(), source.end() - source.begin());
+    }
+    catch(const std::invalid_argument &e) //Program file could not be opened
+    {
+      exitError(std::string("File does not exist! ") + argv[i]);
+    }
+    if(!programs.back().empty() && programs.back().back() != '\n') programs.back() += '\n'; //Like compileBuffer
+  }
+  
+  //Every backend with every level of kernels this machine runs, then every backend in chunks and pipelined with the
+  //best kernels
+  std::vector<ScanSetup> setups;
+  for(int backend = 0; backend < SCANNERS; backend++)
+    for(int skip = 0; skip < SKIPLEVELS; skip++)
+      if(skipSupported(static_cast<SkipLevel>(skip)))
+        setups.push_back({ static_cast<ScannerBackend>(backend), static_cast<SkipLevel>(skip), 1, false });
+  for(int backend = 0; backend < SCANNERS; backend++)
+    setups.push_back({ static_cast<ScannerBackend>(backend), bestSkipLevel(), CHUNK_THREADS, false });
+  for(int backend = 0; backend < SCANNERS; backend++)
+    setups.push_back({ static_cast<ScannerBackend>(backend), bestSkipLevel(), 1, true });
+  
+  //Every parser reads the tokens of the default scanner as they are scanned, then from the pipeline
+  const ScanSetup DIRECT = { DIRECT_scan, bestSkipLevel(), 1, false };
+  const ScanSetup PIPELINED = { DIRECT_scan, bestSkipLevel(), 1, true };
+  const ParseSetup PARSESETUPS[4] = { { DIRECT, DESCENT_parse }, { DIRECT, TABLE_parse }, { PIPELINED, DESCENT_parse },
+                                      { PIPELINED, TABLE_parse } };
+  
+  //Every setup has to build the same tokens, or stop with the same error, as the table scanner with scalar kernels.
+  //Every parser has to build the same tree, or stop with the same error, as the recursive descent parser
+  const size_t PARSECOUNT = sizeof(PARSESETUPS) / sizeof(PARSESETUPS[0]);
+  bool same = true;
+  for(size_t i = 0; i < programs.size(); i++)
+  {
+    same = checkSame(argv[i + first], programs[i], setups, PARSESETUPS, PARSECOUNT) && same;
+    if(checkOnly) same = checkSame(std::string(argv[i + first]) + " padded", padLines(programs[i]), setups,
+                                   PARSESETUPS, PARSECOUNT) && same;
+  }
+  if(checkOnly)
+  {
+    if(same) std::cout << "every setup scans and parses " << programs.size() << " programs the same" << std::endl;
+    return same ? 0 : 1;
+  }
+  
+  for(const ScanSetup& setup : setups)
+  {
+    size_t tokens = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int repeat = 0; repeat < REPEATS; repeat++)
+      for(const std::string& program : programs) tokens += countTokens(program, setup);
+    report(setupName(setup), tokens, std::chrono::steady_clock::now() - start);
+  }
+  
+  //The tokens the parser reads are counted once, it only reads up to the first error as the scanner does
+  size_t parseTokens = 0;
+  for(const std::string& program : programs) parseTokens += countTokens(program, DIRECT);
+  for(const ParseSetup& setup : PARSESETUPS)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for(int repeat = 0; repeat < REPEATS; repeat++)
+      for(const std::string& program : programs) countNodes(program, setup);
+    report(setupName(setup), parseTokens * REPEATS, std::chrono::steady_clock::now() - start);
+  }
+  
+  return same ? 0 : 1;
+}
+
+/*
+ *  Description: Checks every scanner setup builds the same tokens and diagnostic from SOURCE as the first and every
+ *               parser setup the same tree and diagnostic as the first, printing each one that does not.
+ *  Passed: The NAME to print for the program, its SOURCE and the scanner and parser setups to check.
+ *  Return: True if every setup agrees.
+ */
+static bool checkSame(const std::string NAME, const std::string& SOURCE, const std::vector<ScanSetup>& SETUPS,
+                      const ParseSetup* PARSESETUPS, const size_t PARSECOUNT)
+{
+  bool same = true;
+  std::string expected = scanAll(SOURCE, SETUPS[0]);
+  for(size_t setup = 1; setup < SETUPS.size(); setup++)
+  {
+    if(scanAll(SOURCE, SETUPS[setup]) == expected) continue;
+    std::cout << NAME << ": " << setupName(SETUPS[setup]) << " scanner differs from " << setupName(SETUPS[0])
+              << std::endl;
+    same = false;
+  }
+  expected = parseAll(SOURCE, PARSESETUPS[0]);
+  for(size_t setup = 1; setup < PARSECOUNT; setup++)
+  {
+    if(parseAll(SOURCE, PARSESETUPS[setup]) == expected) continue;
+    std::cout << NAME << ": " << setupName(PARSESETUPS[setup]) << " differs from descent" << std::endl;
+    same = false;
+  }
+  
+  return same;
+}
+
+/*
+ *  Description: Pads SOURCE with spaces before every newline but the last so it is big enough for lexChunks to split
+ *               on every thread. Every token keeps its line and column and the end of the program is not moved.
+ *  Passed: The program SOURCE to pad.
+ *  Return: The padded program, SOURCE when it has less than two lines.
+ */
+static std::string padLines(const std::string& SOURCE)
+{
+  size_t last = SOURCE.find_last_of('\n');
+  size_t newlines = static_cast<size_t>(std::count(SOURCE.begin(), SOURCE.end(), '\n'));
+  if(newlines < 2) return SOURCE;
+  
+  const std::string PAD(PAD_BYTES / (newlines - 1), ' ');
+  std::string padded;
+  for(size_t i = 0; i < SOURCE.size(); i++)
+  {
+    if(SOURCE[i] == '\n' && i != last) padded += PAD;
+    padded += SOURCE[i];
+  }
+  
+  return padded;
+}
+
+/*
+ *  Description: Scans SOURCE to the end with SETUP, with a new symbol table like every compile has.
+ *  Passed: The program SOURCE and the backend and kernels to scan with.
+ *  Return: Every token as kind, keyword, text, line and column, one per line, then the error if the scanner threw one.
+ */
+static std::string scanAll(const std::string& SOURCE, const ScanSetup SETUP)
+{
+  SymbolTable symbols;
+  ScannerIn scannerIn(SOURCE.data(), SOURCE.data() + SOURCE.size(), symbols, SETUP.backend);
+  TokenStream stream;
+  std::unique_ptr<ScanPipeline> pipeline;
+  startScan(scannerIn, stream, pipeline, SOURCE, SETUP);
+  std::vector<Token> tokens;
+  std::string error;
+  try
+  {
+    do
+    {
+      tokens.push_back(scanner(scannerIn));
+    } while(tokens.back().kind != EOF_tk);
+  }
+  catch(const std::invalid_argument &e) //Lexical error
+  {
+    error = e.what();
+  }
+  
+  //The text is only read once a pipeline stopped interning
+  if(pipeline != nullptr) pipeline->stop();
+  std::string out;
+  for(const Token& token : tokens)
+  {
+    out += std::to_string(token.kind) + " " + std::to_string(token.keyword) + " ";
+    out += symbols.text(token.symbol);
+    out += " " + std::to_string(token.line) + " " + std::to_string(token.col) + "\n";
+  }
+  
+  return out + error;
+}
+
+/*
+ *  Description: Scans SOURCE to the end with SETUP and a new symbol table, only counting the tokens.
+ *  Passed: The program SOURCE and the backend and kernels to scan with.
+ *  Return: How many tokens were built, the EOF_tk included, up to the error if the scanner threw one.
+ */
+static size_t countTokens(const std::string& SOURCE, const ScanSetup SETUP)
+{
+  SymbolTable symbols;
+  ScannerIn scannerIn(SOURCE.data(), SOURCE.data() + SOURCE.size(), symbols, SETUP.backend);
+  TokenStream stream;
+  std::unique_ptr<ScanPipeline> pipeline;
+  startScan(scannerIn, stream, pipeline, SOURCE, SETUP);
+  size_t tokens = 0;
+  try
+  {
+    while(tokens++, scanner(scannerIn).kind != EOF_tk) {}
+  }
+  catch(const std::invalid_argument &e) //Lexical error
+  {
+  }
+  
+  return tokens;
+}
+
+/*
+ *  Description: Parses SOURCE with SETUP, with a new symbol table and tree like every compile has.
+ *  Passed: The program SOURCE and the parser and scanner setup to parse with.
+ *  Return: What the parser printed, then the root and every node of the tree as kind, tokens, children and next one
+ *          per line.
+ */
+static std::string parseAll(const std::string& SOURCE, const ParseSetup SETUP)
+{
+  SymbolTable symbols;
+  ScannerIn scannerIn(SOURCE.data(), SOURCE.data() + SOURCE.size(), symbols, SETUP.scan.backend);
+  TokenStream stream;
+  std::unique_ptr<ScanPipeline> pipeline;
+  startScan(scannerIn, stream, pipeline, SOURCE, SETUP.scan);
+  Tree tree;
+  std::ostringstream out;
+  NodeId root = parser(scannerIn, tree, out, SETUP.parser);
+  
+  out << "root " << root << "\n";
+  for(NodeId id = 1; root != NO_NODE && id <= tree.size(); id++)
+  {
+    const Node& node = tree[id];
+    out << NODE_NAMES[node.kind];
+    for(int i = 0; i < node.tokenCount; i++)
+      out << " " << node.tokens[i].kind << ":" << node.tokens[i].symbol << ":" << node.tokens[i].line;
+    out << " | " << node.child1 << " " << node.child2 << " " << node.child3 << " " << node.child4 << " " << node.next
+        << "\n";
+  }
+  
+  return out.str();
+}
+
+/*
+ *  Description: Sets the kernels of SETUP and with more than one thread scans SOURCE up front into stream, or when
+ *               SETUP is pipelined starts scanning it on a thread of its own.
+ *  Passed: The scanner position, the stream to fill, where to keep the pipeline, the program SOURCE and the setup to
+ *          scan with.
+ */
+static void startScan(ScannerIn &scannerIn, TokenStream &stream, std::unique_ptr<ScanPipeline> &pipeline,
+                      const std::string& SOURCE, const ScanSetup SETUP)
+{
+  scannerIn.skip = &skipKernels(SETUP.skip);
+  if(SETUP.pipelined) pipeline = std::make_unique<ScanPipeline>(scannerIn);
+  if(SETUP.threads == 1) return;
+  
+  lexChunks(SOURCE.data(), SOURCE.data() + SOURCE.size(), scannerIn.symbols, SETUP.backend, SETUP.threads, stream);
+  scannerIn.stream = &stream;
+}
+
+//Returns the name of SETUP as backend/kernels, with the threads when it scans in chunks or pipelined
+static std::string setupName(const ScanSetup SETUP)
+{
+  std::string name = std::string(SCANNER_NAMES[SETUP.backend]) + "/" + SKIP_NAMES[SETUP.skip];
+  if(SETUP.threads != 1) name += " x" + std::to_string(SETUP.threads);
+  if(SETUP.pipelined) name += " pipelined";
+  return name;
+}
+
+/*
+ *  Description: Parses SOURCE with SETUP and a new symbol table and tree, only counting the nodes.
+ *  Passed: The program SOURCE and the parser and scanner setup to parse with.
+ *  Return: How many nodes were built, 0 if the parser found a error.
+ */
+static size_t countNodes(const std::string& SOURCE, const ParseSetup SETUP)
+{
+  SymbolTable symbols;
+  ScannerIn scannerIn(SOURCE.data(), SOURCE.data() + SOURCE.size(), symbols, SETUP.scan.backend);
+  TokenStream stream;
+  std::unique_ptr<ScanPipeline> pipeline;
+  startScan(scannerIn, stream, pipeline, SOURCE, SETUP.scan);
+  Tree tree;
+  std::ostringstream diag;
+  
+  return parser(scannerIn, tree, diag, SETUP.parser) == NO_NODE ? 0 : tree.size();
+}
+
+//Returns the name of SETUP as parse parser backend/scanner setup
+static std::string setupName(const ParseSetup SETUP)
+{
+  return std::string("parse ") + PARSER_NAMES[SETUP.parser] + "/" + setupName(SETUP.scan);
+}
+
+//Prints how many TOKENS the setup NAME went through in SECONDS and how many that is a second
+static void report(const std::string NAME, const size_t TOKENS, const std::chrono::duration<double> SECONDS)
+{
+  std::cout << NAME << ": " << TOKENS << " tokens in " << SECONDS.count() << "s, "
+            << static_cast<uint64_t>(TOKENS / SECONDS.count()) << " tokens/s" << std::endl;
+}
+
+/*
+ *  Description: Helper function that exits the program on an error.
+ *  Passed: Is passed a string to print.
+ *  Return: Exits the program
+ */
+static void exitError(const std::string S) 
+{
+  std::cout << S << std::endl;
+  exit(1);
+}
\ No newline at end of file
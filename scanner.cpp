@@ -1,30 +1,104 @@
-#include <fstream>
 #include <iostream>
 #include <cctype>
-#include <iomanip>
+#include <stdexcept>
 
 #include "language.h"
 #include "scanner.h"
+#include "pipeline.h"
 
-static char filter(std::ifstream &scannerIn, int &currentCol, int &lookAheadCol);
-static char skipComments(std::ifstream &scannerIn);
+/*
+ * The text of the token being built. While its characters are contiguous in the buffer it is just
+ * a start and length, if a comment splits the token the characters are copied to the spill string.
+ */
+struct TokenText {
+  const char* start = nullptr; //First character of the token in the buffer
+  size_t length = 0;           //How many characters are in the token
+  bool copied = false;         //Set once the token stops being contiguous
+};
+
+//Case of the switch of a direct scanner state for the characters of column COL of STATE_TABLE
+#define DIRECT_CASE(COL) \
+  case COL: \
+    if(directStep<STATE, COL>(scannerIn, text, currentChar, lookAheadCol, token)) return token; \
+    break;
+
+static Token streamToken(TokenStream &stream);
+static Token tableScanner(ScannerIn &scannerIn);
+template<int STATE> static Token directState(ScannerIn &scannerIn, TokenText &text);
+template<int STATE, int COL> static bool directStep(ScannerIn &scannerIn, TokenText &text, const char CURRENTCHAR,
+                                                    const int LOOKAHEADCOL, Token &token);
+template<int STATE> static void skipRun(ScannerIn &scannerIn, TokenText &text);
+constexpr bool skipsRuns(const int STATE);
+static Token endToken(const ScannerIn &scannerIn);
+static char filter(ScannerIn &scannerIn, int &currentCol, int &lookAheadCol);
+static char skipComments(ScannerIn &scannerIn);
+constexpr bool looksAhead(const int STATE);
 static int lookAhead(const int CURRENTSTATE, const int LOOKAHEADCOL);
 static void handleError(const int ERRORSTATE, const int LINE);
-static std::string checkKeyword(const std::string INSTANCE);
+static Token buildToken(ScannerIn &scannerIn, const TokenKind KIND, const TokenText &text);
+static void appendChar(ScannerIn &scannerIn, TokenText &text, const char* position);
+static void appendRun(ScannerIn &scannerIn, TokenText &text, const char* begin, const char* end);
+static std::string_view textView(const ScannerIn &scannerIn, const TokenText &text);
+
+const char* const SCANNER_NAMES[SCANNERS] = { "table", "direct" };
+
+ScannerIn::ScannerIn(const char* begin, const char* end, SymbolTable &symbols, const ScannerBackend BACKEND)
+  : current(begin), end(end), lineStart(begin), line(1), symbols(symbols), backend(BACKEND),
+    skip(&skipKernels(bestSkipLevel())), stream(nullptr), pipeline(nullptr) {}
 
 /*
- *  Description: Builds a single token from a input filestream every time it is called. 
- *               Navigates the DFSA described in STATE_TABLE in language.h.
- *               Returns EOF_tk at the end of input filestream.
+ *  Description: Builds a single token from a input buffer every time it is called. 
+ *               Navigates the DFSA described in STATE_TABLE in language.h with the backend of scannerIn.
+ *               Returns EOF_tk at the end of the input buffer.
  *               Throws a invalid argument error when a non valid token is found.
- *  Passed: A file stream pointing to the input file
- *  Return: Returns a token based on the input from the filestream.
+ *  Passed: The scanner position in the input buffer
+ *  Return: Returns a token based on the input from the buffer.
+ */
+Token scanner(ScannerIn &scannerIn) 
+{
+  if(scannerIn.stream != nullptr) return streamToken(*scannerIn.stream);
+  if(scannerIn.pipeline != nullptr) return scannerIn.pipeline->next();
+  if(scannerIn.backend == TABLE_scan) return tableScanner(scannerIn);
+  
+  TokenText tokenState;
+  return directState<0>(scannerIn, tokenState);
+}
+
+/*
+ *  Description: Gets the text SYMBOL was interned with in the symbol table of scannerIn. A pipeline still interning
+ *               into the table is stopped first, no more tokens are scanned after that.
+ *  Passed: The scanner position in the input buffer and the symbol ID
+ *  Return: The text of the symbol
+ */
+std::string_view symbolText(ScannerIn &scannerIn, const uint32_t SYMBOL)
+{
+  if(scannerIn.pipeline != nullptr) scannerIn.pipeline->stop();
+  return scannerIn.symbols.text(SYMBOL);
+}
+
+/*
+ *  Description: Hands out the next token of STREAM. Once they run out throws the error of the stream as a
+ *               invalid_argument error like the scanner would have, or hands out the last EOF_tk again.
+ *  Passed: The stream of tokens
+ *  Return: The next token
+ */
+static Token streamToken(TokenStream &stream)
+{
+  if(stream.next < stream.tokens.size()) return stream.tokens[stream.next++];
+  if(!stream.error.empty() || stream.tokens.empty()) throw std::invalid_argument(stream.error);
+  
+  return stream.tokens.back();
+}
+
+/*
+ *  Description: Builds a token by looking up the next state of every character in STATE_TABLE.
+ *  Passed: The scanner position in the input buffer
+ *  Return: Returns a token based on the input from the buffer.
  */
-Token scanner(std::ifstream &scannerIn) 
+static Token tableScanner(ScannerIn &scannerIn)
 {
   int currentState = 0;
-  static int line = 1;
-  std::string tokenState = "";
+  TokenText tokenState;
   
   while(currentState < 100)
   {
@@ -33,95 +107,223 @@ Token scanner(std::ifstream &scannerIn)
     
     char currentChar = filter(scannerIn, currentCol, lookAheadCol);
     
-    if(currentChar == '\xff') handleError(1003, line); //char not in language found in filestream
-    if(currentChar == '`') handleError(1004, line); //Invalid comment found by filter
+    if(currentChar == '\xff') handleError(1003, scannerIn.line); //char not in language found in the buffer
+    if(currentChar == '`') handleError(1004, scannerIn.line); //Invalid comment found by filter
     
-    if(currentChar == '\0') return Token("EOF_tk", "EOF", line); //Filter returns '\0' for EOF
+    if(currentChar == '\0') return endToken(scannerIn); //Filter returns '\0' for EOF
     
-    if(currentChar == '\n') line++; //Count Line numbers
-    if(!isspace(currentChar)) tokenState += currentChar; //Don't append whitespaces
+    if(currentChar == '\n') //Count Line numbers
+    {
+      scannerIn.line++;
+      scannerIn.lineStart = scannerIn.current;
+    }
+    if(!isspace(currentChar)) appendChar(scannerIn, tokenState, scannerIn.current - 1); //Don't append whitespaces
     
     currentState = STATE_TABLE[currentState][currentCol];
-    if(currentState >= 1000) handleError(currentState, line); //Error
+    if(currentState >= 1000) handleError(currentState, scannerIn.line); //Error
     if(currentState >= 100) //Final State
     {
-      std::string tokenName = TOKENS.at(currentState); //Get token name
-      
-      return Token(tokenName, tokenState, line);
+      return buildToken(scannerIn, FINAL_TOKENS[currentState - 100], tokenState);
     }
     else
     {
       int lookAheadEnd = lookAhead(currentState, lookAheadCol);
-      if(lookAheadEnd >= 1000) handleError(lookAheadEnd, line); //Error   
+      if(lookAheadEnd >= 1000) handleError(lookAheadEnd, scannerIn.line); //Error   
       if(lookAheadEnd >= 100) //Only used by ID_tk NUM_tk
       {
-        std::string tokenName = TOKENS.at(lookAheadEnd); //Get token name
-        if(tokenName == "ID_tk") tokenName = checkKeyword(tokenState);
-        
-        return Token(tokenName, tokenState, line);
+        return buildToken(scannerIn, FINAL_TOKENS[lookAheadEnd - 100], tokenState);
+      }
+    }
+  }
+  return Token();
+}
+
+/*
+ *  Description: Builds a token in STATE of the DFSA with the direct scanner. Every state is its own copy of this
+ *               function with a switch over the column of the next character, each case goes straight to the
+ *               state STATE_TABLE says it goes to, worked out at compile time (directStep). Characters are read
+ *               the same way as the table scanner reads them.
+ *  Passed: The scanner position in the input buffer and the text of the token so far
+ *  Return: Returns a token based on the input from the buffer.
+ */
+template<int STATE>
+static Token directState(ScannerIn &scannerIn, TokenText &text)
+{
+  static_assert(COLCHARS == 26, "directState needs a case for every column of STATE_TABLE");
+  
+  Token token;
+  while(true)
+  {
+    int currentCol;
+    int lookAheadCol;
+    
+    if constexpr(skipsRuns(STATE)) skipRun<STATE>(scannerIn, text);
+    char currentChar = filter(scannerIn, currentCol, lookAheadCol);
+    
+    if(currentChar == '\xff') handleError(1003, scannerIn.line); //char not in language found in the buffer
+    if(currentChar == '`') handleError(1004, scannerIn.line); //Invalid comment found by filter
+    if(currentChar == '\0') return endToken(scannerIn); //Filter returns '\0' for EOF
+    
+    switch(currentCol)
+    {
+      DIRECT_CASE(0)  DIRECT_CASE(1)  DIRECT_CASE(2)  DIRECT_CASE(3)  DIRECT_CASE(4)  DIRECT_CASE(5)  DIRECT_CASE(6)
+      DIRECT_CASE(7)  DIRECT_CASE(8)  DIRECT_CASE(9)  DIRECT_CASE(10) DIRECT_CASE(11) DIRECT_CASE(12) DIRECT_CASE(13)
+      DIRECT_CASE(14) DIRECT_CASE(15) DIRECT_CASE(16) DIRECT_CASE(17) DIRECT_CASE(18) DIRECT_CASE(19) DIRECT_CASE(20)
+      DIRECT_CASE(21) DIRECT_CASE(22) DIRECT_CASE(23) DIRECT_CASE(24) DIRECT_CASE(25)
+    }
+  }
+}
+
+/*
+ *  Description: Takes the character CURRENTCHAR of column COL in STATE with the direct scanner. Everything about the
+ *               move is known at compile time: if the character is white space, which state it goes to and if that
+ *               state ends the token, is an error or looks ahead. Only the look ahead needs STATE_TABLE at run time.
+ *  Passed: The scanner position, the text of the token so far, the character, the column of the character after
+ *          it and where to save the token when one is built
+ *  Return: True if the token was built, false if the scanner stays in STATE.
+ */
+template<int STATE, int COL>
+static inline bool directStep(ScannerIn &scannerIn, TokenText &text, const char CURRENTCHAR, const int LOOKAHEADCOL,
+                              Token &token)
+{
+  constexpr int NEXT = STATE_TABLE[STATE][COL];
+  
+  if constexpr(COL == CHARCLASS[' ']) //Count line numbers, don't append white spaces
+  {
+    if(CURRENTCHAR == '\n')
+    {
+      scannerIn.line++;
+      scannerIn.lineStart = scannerIn.current;
+    }
+  }
+  else
+  {
+    appendChar(scannerIn, text, scannerIn.current - 1);
+  }
+  
+  if constexpr(NEXT >= 1000) //Error
+  {
+    handleError(NEXT, scannerIn.line);
+  }
+  else if constexpr(NEXT >= 100) //Final State
+  {
+    token = buildToken(scannerIn, FINAL_TOKENS[NEXT - 100], text);
+    return true;
+  }
+  else
+  {
+    if constexpr(looksAhead(NEXT))
+    {
+      int lookAheadEnd = STATE_TABLE[NEXT][LOOKAHEADCOL];
+      if(lookAheadEnd >= 1000) handleError(lookAheadEnd, scannerIn.line); //Error
+      if(lookAheadEnd >= 100)
+      {
+        token = buildToken(scannerIn, FINAL_TOKENS[lookAheadEnd - 100], text);
+        return true;
       }
     }
+    if constexpr(NEXT != STATE)
+    {
+      token = directState<NEXT>(scannerIn, text);
+      return true;
+    }
   }
-  return Token("", "", 0);
+  
+  return false;
+}
+
+/*
+ *  Description: Skips the run of characters STATE stays in with the skip kernels of scannerIn (skip.h): white space
+ *               in state 0, digits in INT_tk and letters, digits and _ in ID_tk. The last character of the run is
+ *               left for directState to take one at a time so what follows the run is looked at the usual way.
+ *               Lines are counted and the characters of a INT_tk or ID_tk added to its text as if taken one by one.
+ *  Passed: The scanner position in the input buffer and the text of the token so far
+ */
+template<int STATE>
+static inline void skipRun(ScannerIn &scannerIn, TokenText &text)
+{
+  const char* begin = scannerIn.current;
+  const char* runEnd;
+  if constexpr(STATE == 0) runEnd = scannerIn.skip->skipSpaces(begin, scannerIn.end);
+  else if constexpr(STATE == 9) runEnd = scannerIn.skip->skipDigits(begin, scannerIn.end);
+  else runEnd = scannerIn.skip->skipWord(begin, scannerIn.end);
+  if(runEnd - begin < 2) return;
+  
+  const char* last = runEnd - 1;
+  if constexpr(STATE == 0) scannerIn.line += scannerIn.skip->countLines(begin, last, scannerIn.lineStart);
+  else appendRun(scannerIn, text, begin, last);
+  scannerIn.current = last;
+}
+
+//Only state 0, INT_tk and ID_tk stay in the same state for runs of characters that matter
+constexpr bool skipsRuns(const int STATE)
+{
+  static_assert(STATE_TABLE[0][CHARCLASS[' ']] == 0 && STATE_TABLE[9][CHARCLASS['0']] == 9 &&
+                STATE_TABLE[10][CHARCLASS['a']] == 10 && STATE_TABLE[10][CHARCLASS['_']] == 10 &&
+                STATE_TABLE[10][CHARCLASS['0']] == 10, "skipRun skips runs STATE_TABLE no longer stays in");
+  return STATE == 0 || STATE == 9 || STATE == 10;
+}
+
+//Returns the EOF_tk at where the scanner is
+static Token endToken(const ScannerIn &scannerIn)
+{
+  return Token(EOF_tk, NOT_kw, scannerIn.symbols.kindSymbol(EOF_tk), scannerIn.line, scannerIn.current - scannerIn.lineStart + 1);
 }
 
 /*
- *  Description: This function reads a char from the filestream skipping comments. Comments are @@word@ 
+ *  Description: This function reads a char from the buffer skipping comments. Comments are @@word@ 
  *               If any chars not in language are found a '\xff' is returned.
- *  Passed: A filestream point to the input file, Integer relating to the currentCol in STATE_TABLE.
+ *               The last char of the buffer is only ever used as lookahead, never returned.
+ *  Passed: The scanner position in the buffer, Integer relating to the currentCol in STATE_TABLE.
  *          A integer relating to the next characters column in the STATE_TABLE
- *  Returns: Char that is the next char in the file stream. The currentCol is the STATE_TABLE column of 
- *           the returned char. LookAheadCol is set as the column of the next chacter in the filestream.
+ *  Returns: Char that is the next char in the buffer. The currentCol is the STATE_TABLE column of 
+ *           the returned char. LookAheadCol is set as the column of the next chacter in the buffer.
  *           If skipComment helper returns ` invalid comment was found. Pass the ` back to the scanner.
  */
-static char filter(std::ifstream &scannerIn, int &currentCol, int &lookAheadCol) 
+static char filter(ScannerIn &scannerIn, int &currentCol, int &lookAheadCol) 
 {
-  char currentChar;
-  scannerIn.get(currentChar);
+  if(scannerIn.current == scannerIn.end) return '\0';
+  char currentChar = *scannerIn.current++;
   
   //Skip comments
   if(currentChar == '@') currentChar = skipComments(scannerIn);
   if(currentChar == '`') return '`'; //Invalid comment
   
-  char lookAhead = scannerIn.peek();
+  if(scannerIn.current == scannerIn.end) return '\0';
   
-  if(scannerIn.eof()) return '\0';
+  char lookAhead = *scannerIn.current;
   
-  try
-  {
-    currentCol = COLMAP.at(currentChar);
-    lookAheadCol = COLMAP.at(lookAhead);
-  } 
-  catch(const std::out_of_range &e)
-  {
-    return '\xff';
-  }
+  currentCol = charClass(currentChar);
+  lookAheadCol = charClass(lookAhead);
+  if(currentCol == ILLEGAL_CHAR || lookAheadCol == ILLEGAL_CHAR) return '\xff';
   
   return currentChar;
 }
 
 /*
  *  Description: Skips comments in the form of @@words@
- *  Passed: The input filestream.
+ *  Passed: The scanner position in the buffer.
  *  Return: Returns the first char after the skipped comment. If the comment has the incorrrect form it will
- *          return `.
+ *          return `. Returns '\0' when the comment runs to the end of the buffer.
  */
-static char skipComments(std::ifstream &scannerIn)
+static char skipComments(ScannerIn &scannerIn)
 {
-  char skipChar;
-  scannerIn.get(skipChar);
-  
   //Requires a double @@ at the start of a comment
-  if(skipChar != '@') return '`';//throw std::invalid_argument("LEXICAL ERROR: Invalid Comment");
+  if(scannerIn.current == scannerIn.end || *scannerIn.current++ != '@') return '`';
     
-  do //Skip until end of comment
-  {
-    scannerIn.get(skipChar);
-    if(scannerIn.eof()) return '`'; //throw std::invalid_argument("LEXICAL ERROR: Invalid Comment");
-  } while(skipChar != '@');
+  //Skip until end of comment (skip.h)
+  scannerIn.current = scannerIn.skip->findByte(scannerIn.current, scannerIn.end, '@');
+  if(scannerIn.current == scannerIn.end) return '`'; //throw std::invalid_argument("LEXICAL ERROR: Invalid Comment");
+  scannerIn.current++;
   
-  scannerIn.get(skipChar);
-  return skipChar;
+  if(scannerIn.current == scannerIn.end) return '\0';
+  return *scannerIn.current++;
+}
+
+//Only the states of INT_tk and ID_tk care about lookahead
+constexpr bool looksAhead(const int STATE)
+{
+  return STATE == 9 || STATE == 10;
 }
 
 /*
@@ -134,8 +336,7 @@ static char skipComments(std::ifstream &scannerIn)
  */
 static int lookAhead(const int CURRENTSTATE, const int LOOKAHEADCOL)
 {
-  //Only INT_tk and ID_tk care about lookahead
-  if(CURRENTSTATE == 9 || CURRENTSTATE == 10)
+  if(looksAhead(CURRENTSTATE))
   {
     return STATE_TABLE[CURRENTSTATE][LOOKAHEADCOL];
   }
@@ -157,13 +358,88 @@ static void handleError(const int ERRORSTATE, const int LINE)
 }
 
 /*
- *  Description: Checks if a given ID_tk state is a KEYWORD or not.
- *  Passed: Passed the current instance of the id.
- *  Returns: KEYWORD_tk if the instance is in the KEYWORD map.
+ *  Description: Builds the token of type KIND for the text the scanner collected. The text is interned,
+ *               ID_tk whose text is a keyword become KEYWORD_tk. Operators spelled the usual way get
+ *               the symbol of their fixed text without looking it up.
+ *  Passed: The scanner position, what type of token was found and the text of the token.
+ *  Returns: The finished token.
+ */
+static Token buildToken(ScannerIn &scannerIn, const TokenKind KIND, const TokenText &text)
+{
+  std::string_view instance = textView(scannerIn, text);
+  int col = text.start - scannerIn.lineStart + 1;
+  
+  if(KIND != ID_tk && KIND != INT_tk && instance.size() == std::char_traits<char>::length(TOKEN_TEXT[KIND]))
+    return Token(KIND, NOT_kw, scannerIn.symbols.kindSymbol(KIND), scannerIn.line, col);
+  
+  uint32_t symbol = scannerIn.symbols.intern(instance);
+  
+  //Keywords are the first symbols in the table
+  if(KIND == ID_tk && symbol < KEYWORDSIZE) return Token(KEYWORD_tk, static_cast<Keyword>(symbol), symbol, scannerIn.line, col);
+  
+  return Token(KIND, NOT_kw, symbol, scannerIn.line, col);
+}
+
+/*
+ *  Description: Adds the char at POSITION in the buffer to the token being built.
+ *               Copies the token to the spill storage the first time it stops being contiguous.
+ *  Passed: The scanner position, the token being built and where the char is in the buffer.
+ */
+static void appendChar(ScannerIn &scannerIn, TokenText &text, const char* position)
+{
+  if(text.copied) //Already copied
+  {
+    scannerIn.spill.push_back(*position);
+  }
+  else if(text.length == 0)
+  {
+    text.start = position;
+    text.length = 1;
+  }
+  else if(position == text.start + text.length) //Still contiguous
+  {
+    text.length++;
+  }
+  else
+  {
+    scannerIn.spill.assign(text.start, text.length);
+    scannerIn.spill.push_back(*position);
+    text.copied = true;
+  }
+}
+
+/*
+ *  Description: Adds the chars from begin up to end in the buffer to the token being built, like appendChar does
+ *               for each of them.
+ *  Passed: The scanner position, the token being built and where the chars are in the buffer.
  */
-static std::string checkKeyword(const std::string INSTANCE) 
+static void appendRun(ScannerIn &scannerIn, TokenText &text, const char* begin, const char* end)
+{
+  if(text.copied) //Already copied
+  {
+    scannerIn.spill.append(begin, end - begin);
+  }
+  else if(text.length == 0)
+  {
+    text.start = begin;
+    text.length = end - begin;
+  }
+  else if(begin == text.start + text.length) //Still contiguous
+  {
+    text.length += end - begin;
+  }
+  else
+  {
+    scannerIn.spill.assign(text.start, text.length);
+    scannerIn.spill.append(begin, end - begin);
+    text.copied = true;
+  }
+}
+
+//Returns a view of the token being built
+static std::string_view textView(const ScannerIn &scannerIn, const TokenText &text)
 {
-  if (KEYWORDS.find(INSTANCE) != KEYWORDS.end()) return "KEYWORD_tk";
+  if(text.copied) return std::string_view(scannerIn.spill);
   
-  return "ID_tk";
+  return std::string_view(text.start, text.length);
 }
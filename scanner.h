@@ -1,7 +1,13 @@
 #ifndef SCANNER_H
 #define SCANNER_H
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "language.h"
+#include "symbols.h"
+#include "skip.h"
 
 
 /*
@@ -29,14 +35,64 @@ Lexical Definitions
     + you may also assume no \n inside
 */
 
+class ScanPipeline;
+
+//Which scanner builds the tokens. Both build the same tokens and throw the same errors
+enum ScannerBackend : uint8_t {
+  TABLE_scan,  //Looks up every character in STATE_TABLE (language.h)
+  DIRECT_scan, //STATE_TABLE turned into a switch per state at compile time, no table lookups
+  SCANNERS     //How many backends there are
+};
+
+//The name of every ScannerBackend as --scanner= takes it, SCANNER_NAMES[backend]
+extern const char* const SCANNER_NAMES[SCANNERS];
+
+/*
+ * Tokens of a whole buffer scanned before the parser asks for them (lexer.h). error is the lexical error the scanner
+ * throws once the tokens run out, the last token is EOF_tk when there is none.
+ */
+struct TokenStream {
+  std::vector<Token> tokens; //Every token in file order
+  std::string error;         //Message of the lexical error after the last token, empty if there is none
+  size_t next = 0;           //Next token scanner() hands out
+};
+
 /*
- *  Description: Builds a single token from a input filestream every time it is called. 
- *               Navigates the DFSA described in STATE_TABLE in language.h.
- *               Returns EOF_tk at the end of input filestream.
+ * Where the scanner is in the input buffer and the symbol table it interns token text into. The skip kernels are the
+ * best this machine runs unless they are set to others.
+ */
+struct ScannerIn {
+  const char* current;    //Next character to read
+  const char* end;        //One past the last character of the buffer
+  const char* lineStart;  //First character of the line the scanner is on
+  int line;               //Line the scanner is on
+  SymbolTable &symbols;   //Where the text of every token is interned
+  std::string spill;      //Holds the text of a token that is not contiguous in the buffer (comment inside a token)
+  ScannerBackend backend; //Which scanner builds the tokens
+  const SkipKernels* skip; //Kernels comments and the runs the direct scanner stays in are skipped with (skip.h)
+  TokenStream* stream;     //When set scanner() hands out its tokens instead of scanning the buffer
+  ScanPipeline* pipeline;  //When set scanner() hands out the tokens it scans on another thread (pipeline.h)
+
+  ScannerIn(const char* begin, const char* end, SymbolTable &symbols, const ScannerBackend BACKEND = DIRECT_scan);
+};
+
+/*
+ *  Description: Builds a single token from a input buffer every time it is called. 
+ *               Navigates the DFSA described in STATE_TABLE in language.h with the backend of scannerIn.
+ *               Hands out the next token of the stream or the pipeline of scannerIn instead when it has one.
+ *               Returns EOF_tk at the end of the input buffer.
  *               Throws a invalid argument error when a non valid token is found.
- *  Passed: A file stream pointing to the input file
- *  Return: Returns a token based on the input from the filestream.
+ *  Passed: The scanner position in the input buffer
+ *  Return: Returns a token based on the input from the buffer.
+ */
+Token scanner(ScannerIn &scannerIn);
+
+/*
+ *  Description: Gets the text SYMBOL was interned with in the symbol table of scannerIn. A pipeline still interning
+ *               into the table is stopped first, no more tokens are scanned after that.
+ *  Passed: The scanner position in the input buffer and the symbol ID
+ *  Return: The text of the symbol
  */
-Token scanner(std::ifstream &scannerIn);
+std::string_view symbolText(ScannerIn &scannerIn, const uint32_t SYMBOL);
 
 #endif
\ No newline at end of file
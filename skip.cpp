@@ -0,0 +1,210 @@
+#include "skip.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define SKIP_X86
+#define AVX2 __attribute__((target("avx2"))) //Built for AVX2 without the rest of the program needing it
+#endif
+
+const char* const SKIP_NAMES[SKIPLEVELS] = { "scalar", "sse2", "avx2" };
+
+/*
+ * The character classes the kernels skip. is checks one byte, on x86 mask16 and mask32 check 16 or 32 bytes at once
+ * and return a bit for every byte in the class, bit i for byte i.
+ */
+struct SpaceClass {
+  static bool is(const char C) { return C == ' ' || C == '\n' || C == '\t' || C == '\r'; }
+#ifdef SKIP_X86
+  static uint32_t mask16(const __m128i V)
+  {
+    __m128i space = _mm_or_si128(_mm_cmpeq_epi8(V, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(V, _mm_set1_epi8('\n')));
+    __m128i control = _mm_or_si128(_mm_cmpeq_epi8(V, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(V, _mm_set1_epi8('\r')));
+    return _mm_movemask_epi8(_mm_or_si128(space, control));
+  }
+  AVX2 static uint32_t mask32(const __m256i V)
+  {
+    __m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(V, _mm256_set1_epi8(' ')),
+                                    _mm256_cmpeq_epi8(V, _mm256_set1_epi8('\n')));
+    __m256i control = _mm256_or_si256(_mm256_cmpeq_epi8(V, _mm256_set1_epi8('\t')),
+                                      _mm256_cmpeq_epi8(V, _mm256_set1_epi8('\r')));
+    return _mm256_movemask_epi8(_mm256_or_si256(space, control));
+  }
+#endif
+};
+
+struct DigitClass {
+  static bool is(const char C) { return C >= '0' && C <= '9'; }
+#ifdef SKIP_X86
+  //V - '0' is at most 9 as a unsigned byte only for digits
+  static uint32_t mask16(const __m128i V)
+  {
+    __m128i offset = _mm_sub_epi8(V, _mm_set1_epi8('0'));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(9)), offset));
+  }
+  AVX2 static uint32_t mask32(const __m256i V)
+  {
+    __m256i offset = _mm256_sub_epi8(V, _mm256_set1_epi8('0'));
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(9)), offset));
+  }
+#endif
+};
+
+struct WordClass {
+  static bool is(const char C) { return DigitClass::is(C) || ((C | 0x20) >= 'a' && (C | 0x20) <= 'z') || C == '_'; }
+#ifdef SKIP_X86
+  //Setting bit 0x20 lower cases a letter, then it is a letter if it is at most 25 past 'a'
+  static uint32_t mask16(const __m128i V)
+  {
+    __m128i offset = _mm_sub_epi8(_mm_or_si128(V, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i letter = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(25)), offset);
+    return DigitClass::mask16(V) | _mm_movemask_epi8(_mm_or_si128(letter, _mm_cmpeq_epi8(V, _mm_set1_epi8('_'))));
+  }
+  AVX2 static uint32_t mask32(const __m256i V)
+  {
+    __m256i offset = _mm256_sub_epi8(_mm256_or_si256(V, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i letter = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(25)), offset);
+    __m256i underscore = _mm256_cmpeq_epi8(V, _mm256_set1_epi8('_'));
+    return DigitClass::mask32(V) | _mm256_movemask_epi8(_mm256_or_si256(letter, underscore));
+  }
+#endif
+};
+
+//Skips the bytes of CLASS one at a time
+template<typename CLASS>
+static const char* skipScalar(const char* begin, const char* end)
+{
+  while(begin != end && CLASS::is(*begin)) begin++;
+  return begin;
+}
+
+static const char* findScalar(const char* begin, const char* end, const char C)
+{
+  while(begin != end && *begin != C) begin++;
+  return begin;
+}
+
+static int countScalar(const char* begin, const char* end, const char* &lineStart)
+{
+  int lines = 0;
+  for(; begin != end; begin++)
+  {
+    if(*begin != '\n') continue;
+    lines++;
+    lineStart = begin + 1;
+  }
+  return lines;
+}
+
+#ifdef SKIP_X86
+//Skips the bytes of CLASS 16 at a time, the last few one at a time
+template<typename CLASS>
+static const char* skipSse2(const char* begin, const char* end)
+{
+  for(; end - begin >= 16; begin += 16)
+  {
+    uint32_t outside = ~CLASS::mask16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin))) & 0xffff;
+    if(outside != 0) return begin + __builtin_ctz(outside);
+  }
+  return skipScalar<CLASS>(begin, end);
+}
+
+static const char* findSse2(const char* begin, const char* end, const char C)
+{
+  __m128i c = _mm_set1_epi8(C);
+  for(; end - begin >= 16; begin += 16)
+  {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    uint32_t found = _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, c));
+    if(found != 0) return begin + __builtin_ctz(found);
+  }
+  return findScalar(begin, end, C);
+}
+
+static int countSse2(const char* begin, const char* end, const char* &lineStart)
+{
+  int lines = 0;
+  __m128i newline = _mm_set1_epi8('\n');
+  for(; end - begin >= 16; begin += 16)
+  {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    uint32_t found = _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline));
+    if(found == 0) continue;
+    lines += __builtin_popcount(found);
+    lineStart = begin + 32 - __builtin_clz(found); //One past the highest bit
+  }
+  return lines + countScalar(begin, end, lineStart);
+}
+
+//Skips the bytes of CLASS 32 at a time, the last few one at a time
+template<typename CLASS>
+AVX2 static const char* skipAvx2(const char* begin, const char* end)
+{
+  for(; end - begin >= 32; begin += 32)
+  {
+    uint32_t outside = ~CLASS::mask32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin)));
+    if(outside != 0) return begin + __builtin_ctz(outside);
+  }
+  return skipScalar<CLASS>(begin, end);
+}
+
+AVX2 static const char* findAvx2(const char* begin, const char* end, const char C)
+{
+  __m256i c = _mm256_set1_epi8(C);
+  for(; end - begin >= 32; begin += 32)
+  {
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    uint32_t found = _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, c));
+    if(found != 0) return begin + __builtin_ctz(found);
+  }
+  return findScalar(begin, end, C);
+}
+
+AVX2 static int countAvx2(const char* begin, const char* end, const char* &lineStart)
+{
+  int lines = 0;
+  __m256i newline = _mm256_set1_epi8('\n');
+  for(; end - begin >= 32; begin += 32)
+  {
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    uint32_t found = _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newline));
+    if(found == 0) continue;
+    lines += __builtin_popcount(found);
+    lineStart = begin + 32 - __builtin_clz(found); //One past the highest bit
+  }
+  return lines + countScalar(begin, end, lineStart);
+}
+#endif
+
+//The kernels of every level, levels this build has no kernels for use the scalar ones
+static const SkipKernels KERNELS[SKIPLEVELS] = {
+  { findScalar, skipScalar<SpaceClass>, skipScalar<DigitClass>, skipScalar<WordClass>, countScalar },
+#ifdef SKIP_X86
+  { findSse2, skipSse2<SpaceClass>, skipSse2<DigitClass>, skipSse2<WordClass>, countSse2 },
+  { findAvx2, skipAvx2<SpaceClass>, skipAvx2<DigitClass>, skipAvx2<WordClass>, countAvx2 }
+#else
+  { findScalar, skipScalar<SpaceClass>, skipScalar<DigitClass>, skipScalar<WordClass>, countScalar },
+  { findScalar, skipScalar<SpaceClass>, skipScalar<DigitClass>, skipScalar<WordClass>, countScalar }
+#endif
+};
+
+bool skipSupported(const SkipLevel LEVEL)
+{
+#ifdef SKIP_X86
+  if(LEVEL == AVX2_skip) return __builtin_cpu_supports("avx2");
+  return LEVEL == SCALAR_skip || LEVEL == SSE2_skip;
+#else
+  return LEVEL == SCALAR_skip;
+#endif
+}
+
+SkipLevel bestSkipLevel()
+{
+  static const SkipLevel BEST = skipSupported(AVX2_skip) ? AVX2_skip
+                               : skipSupported(SSE2_skip) ? SSE2_skip : SCALAR_skip;
+  return BEST;
+}
+
+const SkipKernels& skipKernels(const SkipLevel LEVEL)
+{
+  return KERNELS[LEVEL];
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef SKIP_H
+#define SKIP_H
+
+#include <cstdint>
+
+//Instruction sets the skip kernels are built for, each level runs on every machine the one after it does
+enum SkipLevel : uint8_t {
+  SCALAR_skip, //One byte at a time, runs everywhere
+  SSE2_skip,   //16 bytes at a time, every x86-64 machine has it
+  AVX2_skip,   //32 bytes at a time
+  SKIPLEVELS   //How many levels there are
+};
+
+//The name of every SkipLevel, SKIP_NAMES[level]
+extern const char* const SKIP_NAMES[SKIPLEVELS];
+
+/*
+ * The kernels the scanner (scanner.h) skips runs of characters with. Each one looks at the bytes from begin up to
+ * end, never past it, and returns where the run stops, end when it runs to the end.
+ */
+struct SkipKernels {
+  const char* (*findByte)(const char* begin, const char* end, const char C); //First C
+  const char* (*skipSpaces)(const char* begin, const char* end);             //First byte that is not white space
+  const char* (*skipDigits)(const char* begin, const char* end);             //First byte that is not a digit
+  const char* (*skipWord)(const char* begin, const char* end);               //First byte not a letter, digit or _
+  
+  //Counts the newlines from begin up to end, lineStart is set to the byte after the last one when there is one
+  int (*countLines)(const char* begin, const char* end, const char* &lineStart);
+};
+
+//Checks if this machine can run the kernels of LEVEL
+bool skipSupported(const SkipLevel LEVEL);
+
+//The highest level this machine can run, worked out once
+SkipLevel bestSkipLevel();
+
+//The kernels of LEVEL, it has to be supported
+const SkipKernels& skipKernels(const SkipLevel LEVEL);
+
+#endif
\ No newline at end of file
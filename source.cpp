@@ -0,0 +1,65 @@
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "source.h"
+
+/*
+ * Definition: Maps or reads the file FILENAME.
+ *             Throws a invalid_argument error if the file can not be opened.
+ * Passed:     The name of the file to load
+ */
+SourceBuffer::SourceBuffer(const std::string FILENAME)
+  : data(nullptr), length(0), mapped(false)
+{
+  int fd = open(FILENAME.c_str(), O_RDONLY);
+  if(fd < 0) throw std::invalid_argument("ERROR: scannerIn failed to open");
+
+  struct stat info;
+  if(fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+  {
+    void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(address != MAP_FAILED)
+    {
+      madvise(address, info.st_size, MADV_SEQUENTIAL); //The scanner only moves forward
+      this->data = static_cast<const char*>(address);
+      this->length = info.st_size;
+      this->mapped = true;
+    }
+  }
+  close(fd);
+
+  if(!this->mapped) //Could not map so read the whole file instead
+  {
+    std::ifstream in(FILENAME.c_str(), std::ios::binary);
+    if(in.fail()) throw std::invalid_argument("ERROR: scannerIn failed to open");
+
+    std::stringstream contents;
+    contents << in.rdbuf();
+    this->fallback = contents.str();
+    this->data = this->fallback.data();
+    this->length = this->fallback.size();
+  }
+}
+
+SourceBuffer::~SourceBuffer()
+{
+  if(this->mapped) munmap(const_cast<char*>(this->data), this->length);
+}
+
+//First character of the file
+const char* SourceBuffer::begin() const
+{
+  return this->data;
+}
+
+//One past the last character of the file
+const char* SourceBuffer::end() const
+{
+  return this->data + this->length;
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <string>
+#include <cstddef>
+
+/*
+ * Holds the whole contents of an input file in memory so the scanner can walk it with a pointer.
+ * The file is memory mapped when possible. If mapping fails (empty file, pipe, etc) the file is
+ * read into a buffer instead.
+ */
+class SourceBuffer
+{
+  private:
+    const char* data;     //First character of the file
+    size_t length;        //How many characters are in the file
+    bool mapped;          //True when data points to a mapping that has to be unmapped
+    std::string fallback; //Holds the file when it could not be mapped
+
+  public:
+    /*
+     * Definition: Maps or reads the file FILENAME.
+     *             Throws a invalid_argument error if the file can not be opened.
+     * Passed:     The name of the file to load
+     */
+    SourceBuffer(const std::string FILENAME);
+    ~SourceBuffer();
+
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    const char* begin() const; //First character of the file
+    const char* end() const;   //One past the last character of the file
+};
+
+#endif
\ No newline at end of file
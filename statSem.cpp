@@ -1,114 +1,197 @@
+#include <charconv>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include "statSem.h"
 
 
 
-SemanticTable::SemanticTable()
+static const uint32_t INDEXBITS = 6; //The index starts with 2^INDEXBITS slots
+
+SemanticTable::SemanticTable(SymbolTable& symbols)
+  : symbols(symbols)
 {
   this->table.clear();
+  this->indexBits = INDEXBITS;
+  this->index.assign(size_t(1) << INDEXBITS, 0);
+}
+
+//Returns the symbol table the variable names are interned in
+SymbolTable& SemanticTable::symbolTable()
+{
+  return this->symbols;
 }
 
 /*
- * Definition: Inserts a row into the semantic table
- * Passed:     Variable name and line number it was found on
+ * Definition: Inserts a row into the semantic table. If VARNAME is already in the table the index keeps
+ *             pointing at its first row.
+ * Passed:     Variable name symbol, line number it was found on and symbol of the integer it starts with
  */
-void SemanticTable::insert(const std::string VARNAME, const int LINE)
+void SemanticTable::insert(const uint32_t VARNAME, const int LINE, const uint32_t VALUE)
 {
-  Row newRow = { VARNAME, false, LINE };
+  Row newRow = { VARNAME, false, LINE, VALUE };
   this->table.push_back(newRow);
+  
+  if(this->table.size() * 2 > this->index.size()) this->growIndex(); //Keep the index at most half full
+  
+  size_t slot = this->findSlot(VARNAME);
+  if(this->index[slot] == 0) this->index[slot] = this->table.size();
+}
+
+/*
+ * Definition: Finds the value VARNAME starts the program with
+ * Passed:     The VARNAME symbol and where to save its value
+ * Returns:    False if VARNAME is not a variable or its value does not fit in 32 bits
+ */
+bool SemanticTable::startValue(const uint32_t VARNAME, int32_t& value)
+{
+  int location;
+  if(!this->contains(VARNAME, location)) return false;
+  
+  const Row& ROW = this->table[location];
+  if(ROW.value == ZERO_VALUE)
+  {
+    value = 0;
+    return true;
+  }
+  
+  std::string_view text = this->symbols.text(ROW.value);
+  std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+  return result.ec == std::errc() && result.ptr == text.data() + text.size();
 }
 
 /*
  * Definition: Checks if the table has a given VARNAME.Saves its location in the table to location
- * Passed:     The VARNAME we are looking for and a integer location to save its location in the table
+ * Passed:     The VARNAME symbol we are looking for and a integer location to save its location in the table
  * Returns:    True if found otherwise false
  */
-bool SemanticTable::contains(const std::string VARNAME, int& location)
+bool SemanticTable::contains(const uint32_t VARNAME, int& location)
 {
+  size_t slot = this->findSlot(VARNAME);
+  if(this->index[slot] == 0) return false;
+  
+  location = this->index[slot] - 1;
+  return true;
+}
+
+/*
+ * Definition: Finds the slot of VARNAME in the index with linear probing
+ * Passed:     The VARNAME symbol we are looking for
+ * Returns:    The slot holding VARNAME or the empty slot where it would go
+ */
+size_t SemanticTable::findSlot(const uint32_t VARNAME) const
+{
+  //Fibonacci hashing, symbols are small sequential IDs and the top bits of their product with 2^32 / phi spread
+  //them over the whole index
+  size_t mask = this->index.size() - 1;
+  size_t slot = static_cast<uint32_t>(VARNAME * 2654435769u) >> (32 - this->indexBits);
+  
+  while(this->index[slot] != 0 && this->table[this->index[slot] - 1].varName != VARNAME)
+    slot = (slot + 1) & mask;
+  
+  return slot;
+}
+
+//Doubles the index and puts every row back into it
+void SemanticTable::growIndex()
+{
+  this->indexBits++;
+  this->index.assign(this->index.size() * 2, 0);
+  
   for(size_t i = 0; i < this->table.size(); i++)
   {
-    if(this->table[i].varName == VARNAME)
-    {
-      location = i;
-      return true;
-    }
+    size_t slot = this->findSlot(this->table[i].varName);
+    if(this->index[slot] == 0) this->index[slot] = i + 1;
   }
-  
-  return false;
 }
 
 
 
 /*
- * Definition: This function builds the semantic table. It traverses in preorder.
+ * Definition: This function builds the semantic table. It traverses in preorder using its own stack so
+ *             long statement lists and deep nesting can't overflow the call stack.
  *             Throws a invalid_argument if the variable is declare more than once or if a variable is used without declaration.
- * Passed:     The root of the parse tree
+ * Passed:     The parse tree and its root
  */
-void SemanticTable::buildSemanticTable(const std::unique_ptr<Node>& NODE)
+void SemanticTable::buildSemanticTable(const Tree& TREE, const NodeId NODE)
 {
-  if(NODE != nullptr)
+  std::vector<NodeId> stack; //Nodes left to visit
+  stack.push_back(NODE);
+  
+  while(!stack.empty())
   {
-    if(NODE->label == "varlist") //All variable declarations are in varlist
+    NodeId id = stack.back();
+    stack.pop_back();
+    if(id == NO_NODE) continue;
+    
+    const Node& node = TREE[id];
+    
+    if(node.kind == VARLIST_nd) //All variable declarations are in varlist
     {
       int location = 0; //so we can print where it was first declared
-      if(this->contains(NODE->tokens[0].instance, location))
+      if(this->contains(node.tokens[0].symbol, location))
       {
+        std::string_view name = this->symbols.text(node.tokens[0].symbol);
         std::stringstream error;
-        error << "ERROR Line "<< NODE->tokens[0].line << ": " << NODE->tokens[0].instance << " redeclared!";
-        error << "\nERROR Line " << this->table[location].line << ": " << NODE->tokens[0].instance << " previously declared here!";
+        error << "ERROR Line "<< node.tokens[0].line << ": " << name << " redeclared!";
+        error << "\nERROR Line " << this->table[location].line << ": " << name << " previously declared here!";
         throw std::invalid_argument(error.str());
       }
       
-      this->insert(NODE->tokens[0].instance, NODE->tokens[0].line);
+      this->insert(node.tokens[0].symbol, node.tokens[0].line, node.tokens[1].symbol);
     }
     else //Every other node than varlist
     {
-      if(!NODE->tokens.empty())
+      if(node.tokenCount != 0)
       {
-        if(NODE->tokens[0].tokenId == "ID_tk") //ID is being used make sure it is in the table
+        if(node.tokens[0].kind == ID_tk) //ID is being used make sure it is in the table
         {
           int location = 0;
-          if(this->contains(NODE->tokens[0].instance, location))
+          if(this->contains(node.tokens[0].symbol, location))
           {
             table[location].used = true;
           }
           else
           {
             std::stringstream error;
-            error << "ERROR Line " << NODE->tokens[0].line << ": " << NODE->tokens[0].instance << " undefined!";
+            error << "ERROR Line " << node.tokens[0].line << ": " << this->symbols.text(node.tokens[0].symbol) << " undefined!";
             throw std::invalid_argument(error.str());
           }
         }
       }
     }
     
-    buildSemanticTable(NODE->child1);
-    buildSemanticTable(NODE->child2);
-    buildSemanticTable(NODE->child3);
-    buildSemanticTable(NODE->child4);
+    //Pushed in reverse so the children come off first and the next item in the list after them
+    stack.push_back(node.next);
+    stack.push_back(node.child4);
+    stack.push_back(node.child3);
+    stack.push_back(node.child2);
+    stack.push_back(node.child1);
   }
 }
 
-//Definition: Prints warning if a variable has not been used by the program
-void SemanticTable::printWarnings()
+//Definition: Prints warning to diag if a variable has not been used by the program
+void SemanticTable::printWarnings(std::ostream& diag)
 {
   for(size_t i = 0; i < this->table.size(); i++)
   {
     if(!table[i].used)
     {
-      std::cout << "WARNING Line " << table[i].line << ": " << table[i].varName << " assigned but never used!" << std::endl;
+      diag << "WARNING Line " << table[i].line << ": " << this->symbols.text(table[i].varName) << " assigned but never used!" << std::endl;
     
     }
   }
 }
 
 
-void SemanticTable::tableOut(std::ofstream& fileOut)
+void SemanticTable::tableOut(AsmWriter& writer)
 {
   for(size_t i = 0; i < this->table.size(); i++)
-    fileOut << table[i].varName << " 0" << std::endl;
+  {
+    std::string_view value = table[i].value == ZERO_VALUE ? "0" : this->symbols.text(table[i].value);
+    writer.variable(this->symbols.text(table[i].varName), value);
+  }
 }
 
 
@@ -116,21 +199,22 @@ void SemanticTable::tableOut(std::ofstream& fileOut)
  * Definition: This function checks the static semantics of the given parse tree and generates a table of variables in the program.
  *             Scope is global. Redecleration of variables or using without being initialized is an error/
  *             The fucntion then prints warnings for variables declared but not used.
- * Passed:     The root of the parse tree generated by the parser for the language.            
+ * Passed:     The parse tree generated by the parser for the language, its root, the symbol table it used
+ *             and the stream to print errors and warnings to.
  * Returns:    A pointer to the generated semantic table.
  */
-std::unique_ptr<SemanticTable> buildTable(const std::unique_ptr<Node>& ROOT)
+std::unique_ptr<SemanticTable> buildTable(const Tree& TREE, const NodeId ROOT, SymbolTable& symbols, std::ostream& diag)
 {
   
-  std::unique_ptr<SemanticTable> table(new SemanticTable());
+  std::unique_ptr<SemanticTable> table(new SemanticTable(symbols));
   try
   {
-    table->buildSemanticTable(ROOT); //Build sematic table (statsem.h)
-    table->printWarnings();
+    table->buildSemanticTable(TREE, ROOT); //Build sematic table (statsem.h)
+    table->printWarnings(diag);
   } 
   catch(const std::invalid_argument &e) //Error in static semantics
   {
-    std::cout << e.what() << std::endl;
+    diag << e.what() << std::endl;
     table = nullptr; //We errored 
   }
   
@@ -2,9 +2,12 @@
 #define STATSEM_H
 
 #include <vector>
-#include <fstream>
+#include <ostream>
+#include <memory>
 
 #include "tree.h"
+#include "symbols.h"
+#include "asmWriter.h"
 
 /*
 Static Semantics Definition
@@ -20,57 +23,84 @@ Static Semantics Definition
 
 
 
+const uint32_t ZERO_VALUE = UINT32_MAX; //Starting value of a variable the compiler made, written as 0
+
 class SemanticTable 
 {
   private:
     struct Row 
     {
-      std::string varName;
+      uint32_t varName; //Symbol ID of the variable name
       bool used;
       int line;
+      uint32_t value;   //Symbol ID of the integer the variable was declared with or ZERO_VALUE
     };
-    std::vector<Row> table; //The semantic table
+    std::vector<Row> table;      //The semantic table, rows stay in the order they were inserted
+    std::vector<uint32_t> index; //Open addressing hash index of the rows by varName. Holds row number + 1, 0 is empty
+    uint32_t indexBits;          //The index has 2^indexBits slots
+    SymbolTable& symbols;        //Where the variable names are interned
+    
+    /*
+     * Definition: Finds the slot of VARNAME in the index with linear probing
+     * Passed:     The VARNAME symbol we are looking for
+     * Returns:    The slot holding VARNAME or the empty slot where it would go
+     */
+    size_t findSlot(const uint32_t VARNAME) const;
+    
+    //Doubles the index and puts every row back into it
+    void growIndex();
     
     /*
      * Definition: Checks if the table has a given VARNAME.Saves its location in the table to location
-     * Passed:     The VARNAME we are looking for and a integer location to save its location in the table
+     * Passed:     The VARNAME symbol we are looking for and a integer location to save its location in the table
      * Returns:    True if found otherwise false
      */
-    bool contains(const std::string VARNAME, int& location);
+    bool contains(const uint32_t VARNAME, int& location);
     
     
   public:
     /*
      * Definition: This function builds the semantic table. It traverses in preorder.
      *             Throws a invalid_argument if the variable is declare more than once or if a variable is used without declaration.
-     * Passed:     The root of the parse tree
+     * Passed:     The parse tree and its root
      */
-    void buildSemanticTable(const std::unique_ptr<Node>& NODE);
+    void buildSemanticTable(const Tree& TREE, const NodeId NODE);
     
     /*
      * Definition: Inserts a row into the semantic table
-     * Passed:     Variable name and line number it was found on
+     * Passed:     Variable name symbol, line number it was found on and symbol of the integer it starts with
      */
-    void insert(const std::string VARNAME, const int LINE);
+    void insert(const uint32_t VARNAME, const int LINE, const uint32_t VALUE = ZERO_VALUE);
+    
+    /*
+     * Definition: Finds the value VARNAME starts the program with
+     * Passed:     The VARNAME symbol and where to save its value
+     * Returns:    False if VARNAME is not a variable or its value does not fit in 32 bits
+     */
+    bool startValue(const uint32_t VARNAME, int32_t& value);
+    
+    //Definition: Prints warning to diag if a variable has not been used by the program
+    void printWarnings(std::ostream& diag);
     
-    //Definition: Prints warning if a variable has not been used by the program
-    void printWarnings();
+    //Appends the semantic table variable names followed by their starting value to the target being written
+    //EXP: x1 5
+    void tableOut(AsmWriter& writer);
     
-    //Prints the semantic table variable names follow by 0 to the given ofstream
-    //EXP: x1 0
-    void tableOut(std::ofstream& fileOut);
+    //Returns the symbol table the variable names are interned in
+    SymbolTable& symbolTable();
     
-    SemanticTable();
+    SemanticTable(SymbolTable& symbols);
 };
 
 /*
  * Definition: This function checks the static semantics of the given parse tree and generates a table of variables in the program.
  *             Scope is global. Redecleration of variables or using without being initialized is an error/
  *             The fucntion then prints warnings for variables declared but not used.
- * Passed:     The root of the parse tree generated by the parser for the language.            
+ * Passed:     The parse tree generated by the parser for the language, its root, the symbol table it used
+ *             and the stream to print errors and warnings to.
  * Returns:    A pointer to the generated semantic table.
  */
-std::unique_ptr<SemanticTable> buildTable(const std::unique_ptr<Node>& ROOT);
+std::unique_ptr<SemanticTable> buildTable(const Tree& TREE, const NodeId ROOT, SymbolTable& symbols, std::ostream& diag);
 
 
 
@@ -0,0 +1,31 @@
+#include "symbols.h"
+
+SymbolTable::SymbolTable()
+{
+  for(int i = 0; i < KEYWORDSIZE; i++) //Keywords first so their ID is their Keyword value
+    this->intern(KEYWORD_TEXT[i]);
+
+  for(int i = 0; i < TOKENKINDS; i++)
+    this->kindSymbols[i] = this->intern(TOKEN_TEXT[i]);
+}
+
+/*
+ * Definition: Finds the symbol ID of TEXT, adding it to the table if it is not there yet.
+ * Passed:     The text to intern
+ * Returns:    The symbol ID of the text
+ */
+uint32_t SymbolTable::intern(const std::string_view TEXT)
+{
+  std::unordered_map<std::string_view, uint32_t>::const_iterator found = this->index.find(TEXT);
+  if(found != this->index.end()) return found->second;
+
+  //The deque never moves its strings so views of them stay valid
+  this->storage.emplace_back(TEXT);
+  std::string_view stored(this->storage.back());
+
+  uint32_t id = this->texts.size();
+  this->texts.push_back(stored);
+  this->index.emplace(stored, id);
+
+  return id;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef SYMBOLS_H
+#define SYMBOLS_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "language.h"
+
+/*
+ * Interns the text of every token into a 32-bit symbol ID. Shared by the scanner, parser, semantic table
+ * and code generator so they compare and store IDs instead of strings. Interning the same text twice
+ * returns the same ID.
+ * The keywords are interned first so a keyword's symbol ID is its Keyword value.
+ */
+class SymbolTable
+{
+  private:
+    std::deque<std::string> storage;                      //Owns the text of every symbol
+    std::vector<std::string_view> texts;                  //Text of every symbol, texts[id]
+    std::unordered_map<std::string_view, uint32_t> index; //Finds the ID of a text
+    uint32_t kindSymbols[TOKENKINDS];                     //ID of the fixed text of every token type
+
+  public:
+    SymbolTable();
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /*
+     * Definition: Finds the symbol ID of TEXT, adding it to the table if it is not there yet.
+     * Passed:     The text to intern
+     * Returns:    The symbol ID of the text
+     */
+    uint32_t intern(const std::string_view TEXT);
+
+    //Returns the text of the symbol ID
+    std::string_view text(const uint32_t ID) const { return this->texts[ID]; }
+
+    //Returns the symbol ID of the text a token type is always spelled as (TOKEN_TEXT)
+    uint32_t kindSymbol(const TokenKind KIND) const { return this->kindSymbols[KIND]; }
+
+    //Returns how many symbols are in the table
+    size_t size() const { return this->texts.size(); }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <thread>
+
+#include "threadPool.h"
+
+/*
+ * Definition: Makes a pool of WORKERS workers. 0 uses one worker per core.
+ * Passed:     How many workers to use
+ */
+ThreadPool::ThreadPool(size_t workers)
+{
+  if(workers == 0) workers = std::thread::hardware_concurrency();
+  if(workers == 0) workers = 1; //Core count is unknown
+  
+  for(size_t i = 0; i < workers; i++)
+    this->queues.emplace_back(new Queue);
+}
+
+//Returns how many workers the pool has
+size_t ThreadPool::size() const
+{
+  return this->queues.size();
+}
+
+/*
+ * Definition: Runs JOB(i) for every i from 0 to JOBCOUNT-1 on the workers and waits for all of them to finish.
+ *             The calling thread is one of the workers. JOB must be safe to run on several threads at once.
+ * Passed:     How many jobs there are and the function that runs one job
+ */
+void ThreadPool::run(const size_t JOBCOUNT, const std::function<void(size_t)>& JOB)
+{
+  size_t workers = this->queues.size();
+  if(workers > JOBCOUNT) workers = JOBCOUNT;
+  if(workers == 0) return;
+  
+  //Deal every worker a run of jobs in order, the workers take them from the back
+  for(size_t i = 0; i < JOBCOUNT; i++)
+    this->queues[i * workers / JOBCOUNT]->jobs.push_front(i);
+  
+  std::vector<std::thread> threads;
+  for(size_t i = 1; i < workers; i++)
+    threads.emplace_back(&ThreadPool::work, this, i, std::cref(JOB));
+  
+  this->work(0, JOB);
+  
+  for(size_t i = 0; i < threads.size(); i++)
+    threads[i].join();
+}
+
+/*
+ * Definition: Loop of a single worker. Runs jobs from its own queue then steals until every queue is empty.
+ *             No jobs are added while the workers run so once every queue is empty there is nothing left to do.
+ * Passed:     Which worker this is and the function that runs one job
+ */
+void ThreadPool::work(const size_t WORKER, const std::function<void(size_t)>& JOB)
+{
+  size_t job;
+  while(this->popJob(WORKER, job) || this->stealJob(WORKER, job))
+    JOB(job);
+}
+
+//Takes a job from the back of the workers own queue. Returns false if the queue is empty.
+bool ThreadPool::popJob(const size_t WORKER, size_t& job)
+{
+  Queue& queue = *this->queues[WORKER];
+  std::lock_guard<std::mutex> guard(queue.lock);
+  if(queue.jobs.empty()) return false;
+  
+  job = queue.jobs.back();
+  queue.jobs.pop_back();
+  return true;
+}
+
+//Takes a job from the front of another workers queue, starting with the next worker. Returns false if every queue is empty.
+bool ThreadPool::stealJob(const size_t WORKER, size_t& job)
+{
+  for(size_t i = 1; i < this->queues.size(); i++)
+  {
+    Queue& queue = *this->queues[(WORKER + i) % this->queues.size()];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if(queue.jobs.empty()) continue;
+    
+    job = queue.jobs.front();
+    queue.jobs.pop_front();
+    return true;
+  }
+  
+  return false;
+}
\ No newline at end of file
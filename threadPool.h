@@ -0,0 +1,51 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * Work stealing pool for running a batch of independent jobs. Jobs are numbered 0 to jobCount-1 and
+ * dealt out to one queue per worker. A worker takes jobs from the back of its own queue and when that
+ * runs dry steals from the front of the other queues, so a few slow jobs don't leave the other workers idle.
+ */
+class ThreadPool
+{
+  private:
+    struct Queue
+    {
+      std::mutex lock;         //Guards jobs, held only to push or pop
+      std::deque<size_t> jobs; //Numbers of the jobs waiting in this queue
+    };
+    std::vector<std::unique_ptr<Queue>> queues; //One queue per worker
+    
+    bool popJob(const size_t WORKER, size_t& job);   //Takes a job from the back of the workers own queue
+    bool stealJob(const size_t WORKER, size_t& job); //Takes a job from the front of another workers queue
+    void work(const size_t WORKER, const std::function<void(size_t)>& JOB);
+    
+  public:
+    /*
+     * Definition: Makes a pool of WORKERS workers. 0 uses one worker per core.
+     * Passed:     How many workers to use
+     */
+    ThreadPool(size_t workers = 0);
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /*
+     * Definition: Runs JOB(i) for every i from 0 to JOBCOUNT-1 on the workers and waits for all of them to finish.
+     *             The calling thread is one of the workers. JOB must be safe to run on several threads at once.
+     * Passed:     How many jobs there are and the function that runs one job
+     */
+    void run(const size_t JOBCOUNT, const std::function<void(size_t)>& JOB);
+    
+    //Returns how many workers the pool has
+    size_t size() const;
+};
+
+#endif
\ No newline at end of file
@@ -1,44 +1,78 @@
 #include <iostream>
+#include <vector>
+#include <utility>
 
 #include "tree.h"
 #include "language.h"
 
-//Constructor for a Node when passed a string
-Node::Node(std::string s) 
+const char* const NODE_NAMES[NODEKINDS] = {
+  "program", "vars", "varlist", "stats", "stat", "block", "read", "print",
+  "cond", "iter", "assign", "relational", "exp", "exp2", "M", "M2", "N", "N2", "R"
+};
+
+Tree::Tree()
+  : count(1) //ID 0 is NO_NODE
 {
-  this->label = s; 
-  this->tokens.clear(); 
-  this->child1 = nullptr; 
-  this->child2 = nullptr; 
-  this->child3 = nullptr; 
-  this->child4 = nullptr; 
+  this->blocks.emplace_back(new Node[BLOCKSIZE]);
+}
+
+//Allocates a node of type KIND with no tokens or children and returns its ID
+NodeId Tree::newNode(const NodeKind KIND)
+{
+  if((this->count >> BLOCKBITS) == this->blocks.size()) //Current block is full
+    this->blocks.emplace_back(new Node[BLOCKSIZE]);
+
+  NodeId id = this->count++;
+  Node& node = (*this)[id];
+  node.kind = KIND;
+  node.tokenCount = 0;
+  node.child1 = NO_NODE;
+  node.child2 = NO_NODE;
+  node.child3 = NO_NODE;
+  node.child4 = NO_NODE;
+  node.next = NO_NODE;
+
+  return id;
 }
 
 /*
- * Prints the tree in pre order traversal
- * Is passed the root, initial level of 0.
+ * Prints the tree in pre order traversal. List items are printed at the same level one after another.
+ * Uses its own stack so long lists and deep trees can't overflow the call stack.
+ * Is passed the tree, the root, initial level of 0 and the symbol table the tokens were interned in.
  * Prints to cout.
  */
-void printPreorder(const std::unique_ptr<Node>& NODE, int level)
+void printPreorder(const Tree& TREE, const NodeId NODE, int level, const SymbolTable& symbols)
 {
-  if(NODE != nullptr) 
+  std::vector<std::pair<NodeId, int>> stack; //Nodes left to print and their levels
+  stack.emplace_back(NODE, level);
+  
+  while(!stack.empty())
   {
+    NodeId id = stack.back().first;
+    level = stack.back().second;
+    stack.pop_back();
+    if(id == NO_NODE) continue;
+    
+    const Node& node = TREE[id];
+    
     //Add 2 blank spaces per level
     for(int i = 0; i < level; i++) 
       std::cout << "  ";
     
-    std::cout << NODE->label << ": ";
+    std::cout << NODE_NAMES[node.kind] << ": ";
     
-    for(size_t i = 0; i < NODE->tokens.size(); i++) //Print all tokens
+    for(int i = 0; i < node.tokenCount; i++) //Print all tokens
     {
-      std::cout << NODE->tokens[i].tokenId << " = " << NODE->tokens[i].instance << "|";
+      std::cout << TOKEN_NAMES[node.tokens[i].kind] << " = " << symbols.text(node.tokens[i].symbol) << "|";
     
     }
     std::cout << std::endl;
     
-    printPreorder(NODE->child1, level+1);
-    printPreorder(NODE->child2, level+1);
-    printPreorder(NODE->child3, level+1);
-    printPreorder(NODE->child4, level+1);
+    //Pushed in reverse so the children come off first and the next item in the list after them
+    stack.emplace_back(node.next, level);
+    stack.emplace_back(node.child4, level+1);
+    stack.emplace_back(node.child3, level+1);
+    stack.emplace_back(node.child2, level+1);
+    stack.emplace_back(node.child1, level+1);
   }
-}
+}
\ No newline at end of file
@@ -3,25 +3,75 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 #include "language.h"
+#include "symbols.h"
+
+//Every type of node, one for each nonterminal in the BNF.
+//<mStat> and <varlist2> have no nodes, their items are linked through Node::next instead
+enum NodeKind : uint8_t {
+  PROGRAM_nd, VARS_nd, VARLIST_nd, STATS_nd, STAT_nd, BLOCK_nd, READ_nd, PRINT_nd,
+  COND_nd, ITER_nd, ASSIGN_nd, RELATIONAL_nd, EXP_nd, EXP2_nd, M_nd, M2_nd, N_nd, N2_nd, R_nd,
+  NODEKINDS //How many node types there are
+};
+
+//The label of every node type, NODE_NAMES[kind]
+extern const char* const NODE_NAMES[NODEKINDS];
+
+typedef uint32_t NodeId; //Index of a node in its Tree
+const NodeId NO_NODE = 0; //Stands for a missing child, no node ever has this ID
+
+const int NODETOKENS = 2; //The most tokens any nonterminal holds
 
 struct Node {
-  std::string label; //What type of node this is
-  std::vector<Token> tokens; //Holds all tokens of this non terminal
-  std::unique_ptr<Node> child1 = nullptr; //Pointer for the first child node
-  std::unique_ptr<Node> child2 = nullptr; //Pointer for the second child node
-  std::unique_ptr<Node> child3 = nullptr; //Pointer for the third child node
-  std::unique_ptr<Node> child4 = nullptr; //Pointer for the fourth child node
-  Node(std::string s); //Constructor which is passed a string
+  NodeKind kind;            //What type of node this is
+  uint8_t tokenCount;       //How many tokens this node holds
+  Token tokens[NODETOKENS]; //Holds all tokens of this non terminal
+  NodeId child1;            //ID of the first child node
+  NodeId child2;            //ID of the second child node
+  NodeId child3;            //ID of the third child node
+  NodeId child4;            //ID of the fourth child node
+  NodeId next;              //ID of the next item in a statement or variable list
+
+  void addToken(const Token& TOKEN) { this->tokens[this->tokenCount++] = TOKEN; }
+};
+
+/*
+ * Arena holding every node of a parse tree. Nodes are bump allocated into large blocks and referenced
+ * by 32-bit IDs. Nodes never move so references to them stay valid while the tree grows.
+ * The whole tree is freed at once when the Tree is destroyed.
+ */
+class Tree
+{
+  private:
+    static const uint32_t BLOCKBITS = 12;              //Each block holds 2^BLOCKBITS nodes
+    static const uint32_t BLOCKSIZE = 1u << BLOCKBITS;
+    std::vector<std::unique_ptr<Node[]>> blocks;       //The storage for the nodes
+    uint32_t count;                                    //How many IDs have been handed out
+
+  public:
+    Tree();
+
+    Tree(const Tree&) = delete;
+    Tree& operator=(const Tree&) = delete;
+
+    //Allocates a node of type KIND with no tokens or children and returns its ID
+    NodeId newNode(const NodeKind KIND);
+
+    Node& operator[](const NodeId ID) { return this->blocks[ID >> BLOCKBITS][ID & (BLOCKSIZE - 1)]; }
+    const Node& operator[](const NodeId ID) const { return this->blocks[ID >> BLOCKBITS][ID & (BLOCKSIZE - 1)]; }
+
+    //Returns how many nodes are in the tree
+    size_t size() const { return this->count - 1; }
 };
 
 /*
- * Prints the tree in pre order traversal
- * Is passed the root, initial level of 0.
+ * Prints the tree in pre order traversal. List items are printed at the same level one after another.
+ * Is passed the tree, the root, initial level of 0 and the symbol table the tokens were interned in.
  * Prints to cout.
  */
-void printPreorder(const std::unique_ptr<Node>& NODE, int level);
+void printPreorder(const Tree& TREE, const NodeId NODE, int level, const SymbolTable& symbols);
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include <chrono>
+#include <climits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "vm.h"
+
+static bool nextWord(const std::string_view LINE, size_t& position, std::string_view& word);
+static bool isInteger(const std::string_view WORD);
+static int32_t toInteger(const std::string_view WORD);
+static void handleError(const std::string MESSAGE, const int LINE);
+static void runError(const Program& PROGRAM, const size_t INSTRUCTION, const std::string MESSAGE);
+
+//An instruction as it was written, resolved once every label and variable is known
+struct RawInstruction {
+  Opcode op;
+  std::string_view argument; //"" if there was none
+  int line;
+};
+
+/*
+ * Description: Decodes the target program in SOURCE. Each line is either [label:] instruction [argument]
+ *              or a variable followed by its starting value.
+ *              Throws a invalid_argument error if the program is malformed.
+ * Passed:      The text of the program
+ * Returns:     The decoded program
+ */
+Program loadProgram(const std::string_view SOURCE)
+{
+  Program program;
+  std::vector<RawInstruction> raw;
+  std::unordered_map<std::string_view, uint32_t> labels;    //Label to the index of its instruction
+  std::unordered_map<std::string_view, uint32_t> variables; //Variable to its memory cell
+  
+  //First pass finds every instruction, label and variable
+  size_t lineStart = 0;
+  for(int line = 1; lineStart < SOURCE.size(); line++)
+  {
+    size_t lineEnd = SOURCE.find('\n', lineStart);
+    if(lineEnd == std::string_view::npos) lineEnd = SOURCE.size();
+    std::string_view text = SOURCE.substr(lineStart, lineEnd - lineStart);
+    lineStart = lineEnd + 1;
+    
+    size_t position = 0;
+    std::string_view word;
+    if(!nextWord(text, position, word)) continue; //Blank line
+    
+    if(word.back() == ':') //Label for the instruction on this line
+    {
+      labels[word.substr(0, word.size() - 1)] = raw.size();
+      program.labels.emplace_back(raw.size(), word.substr(0, word.size() - 1));
+      if(!nextWord(text, position, word)) continue;
+    }
+    
+    Opcode op;
+    if(findOpcode(word, op))
+    {
+      std::string_view argument;
+      nextWord(text, position, argument); //Anything after the argument is ignored
+      raw.push_back({ op, argument, line });
+    }
+    else //Variable and its starting value
+    {
+      std::string_view value;
+      if(!nextWord(text, position, value) || !isInteger(value))
+        handleError("Variable name must be followed by integer value", line);
+      if(variables.count(word) != 0)
+        handleError("Multiply defined variable", line);
+      
+      variables[word] = program.memory.size();
+      program.memory.push_back(toInteger(value));
+      program.names.emplace_back(word);
+    }
+  }
+  
+  //Second pass turns every argument into a memory cell or instruction index
+  std::unordered_map<int32_t, uint32_t> constants; //Integer operand to its memory cell
+  for(size_t i = 0; i < raw.size(); i++)
+  {
+    Instruction instruction = { raw[i].op, 0 };
+    std::string_view argument = raw[i].argument;
+    Operand operand = OPCODE_OPERANDS[raw[i].op];
+    
+    if(operand != NONE_arg && argument.empty()) handleError("invalid argument", raw[i].line);
+    
+    if(operand == LABEL_arg)
+    {
+      auto label = labels.find(argument);
+      if(label == labels.end()) handleError("BRs must be followed by defined labels", raw[i].line);
+      instruction.arg = label->second;
+    }
+    else if(operand != NONE_arg && isInteger(argument))
+    {
+      if(operand == VARIABLE_arg) handleError("invalid argument", raw[i].line); //Can't store to a number
+      
+      int32_t value = toInteger(argument);
+      auto constant = constants.find(value);
+      if(constant == constants.end()) //First use of this integer, give it a cell
+      {
+        constant = constants.emplace(value, program.memory.size()).first;
+        program.memory.push_back(value);
+      }
+      instruction.arg = constant->second;
+    }
+    else if(operand != NONE_arg)
+    {
+      auto variable = variables.find(argument);
+      if(variable == variables.end()) handleError("Unknown argument", raw[i].line);
+      instruction.arg = variable->second;
+    }
+    
+    program.code.push_back(instruction);
+  }
+  
+  program.code.push_back({ STOP_op, 0 }); //Running off the end stops the program
+  
+  return program;
+}
+
+/*
+ * Description: Runs PROGRAM until STOP. READ prompts on out and reads from in, WRITE prints to out.
+ *              Arithmetic wraps at 32 bits. Throws a invalid_argument error on division by zero and INT_MIN / -1,
+ *              ending in the source line of the division when PROGRAM has it.
+ *              Every instruction is given the address of its handler up front and each handler jumps
+ *              straight to the next one (computed goto) instead of going back through a switch.
+ * Passed:      The program to run, the streams it reads and writes and where to save what it did.
+ */
+void runProgram(const Program& PROGRAM, std::istream& in, std::ostream& out, VmStats& stats)
+{
+  //Order matches Opcode
+  static const void* const HANDLERS[OPCODES] = {
+    &&BR_h, &&BRNEG_h, &&BRZNEG_h, &&BRPOS_h, &&BRZPOS_h, &&BRZERO_h,
+    &&LOAD_h, &&STORE_h, &&ADD_h, &&SUB_h, &&MULT_h, &&DIV_h, &&READ_h, &&WRITE_h, &&NOOP_h, &&STOP_h
+  };
+  
+  struct Threaded {
+    const void* handler; //Where the code for this instruction is
+    uint32_t arg;        //Same as Instruction::arg
+  };
+  
+  std::vector<Threaded> threaded(PROGRAM.code.size());
+  for(size_t i = 0; i < PROGRAM.code.size(); i++)
+    threaded[i] = { HANDLERS[PROGRAM.code[i].op], PROGRAM.code[i].arg };
+  
+  std::vector<int32_t> memory = PROGRAM.memory;
+  int32_t* cell = memory.data();
+  const Threaded* start = threaded.data();
+  const Threaded* ip = start; //Instruction being run
+  int32_t acc = 0;            //The accumulator
+  uint64_t count = 0;
+  
+  auto begin = std::chrono::steady_clock::now();
+  
+  //Counts the instruction and jumps to the handler of the next one
+  #define DISPATCH() do { count++; goto *ip->handler; } while(0)
+  //Adds with wrap around, the target is a 32 bit machine
+  #define WRAP(A, OP, B) static_cast<int32_t>(static_cast<uint32_t>(A) OP static_cast<uint32_t>(B))
+  
+  DISPATCH();
+  
+  BR_h:     ip = start + ip->arg; DISPATCH();
+  BRNEG_h:  ip = acc < 0 ? start + ip->arg : ip + 1; DISPATCH();
+  BRZNEG_h: ip = acc <= 0 ? start + ip->arg : ip + 1; DISPATCH();
+  BRPOS_h:  ip = acc > 0 ? start + ip->arg : ip + 1; DISPATCH();
+  BRZPOS_h: ip = acc >= 0 ? start + ip->arg : ip + 1; DISPATCH();
+  BRZERO_h: ip = acc == 0 ? start + ip->arg : ip + 1; DISPATCH();
+  LOAD_h:   acc = cell[ip->arg]; ip++; DISPATCH();
+  STORE_h:  cell[ip->arg] = acc; ip++; DISPATCH();
+  ADD_h:    acc = WRAP(acc, +, cell[ip->arg]); ip++; DISPATCH();
+  SUB_h:    acc = WRAP(acc, -, cell[ip->arg]); ip++; DISPATCH();
+  MULT_h:   acc = WRAP(acc, *, cell[ip->arg]); ip++; DISPATCH();
+  DIV_h:
+  {
+    int32_t divisor = cell[ip->arg];
+    //Both fault on the target machine
+    if(divisor == 0) runError(PROGRAM, ip - start, "Error: Division by zero");
+    if(acc == INT32_MIN && divisor == -1) runError(PROGRAM, ip - start, "Error: Division overflow");
+    acc /= divisor;
+    ip++;
+    DISPATCH();
+  }
+  READ_h:
+  {
+    out << "Give number: ";
+    int32_t value;
+    if(in >> value) cell[ip->arg] = value;
+    else in.clear(); //No number, the variable keeps its value
+    ip++;
+    DISPATCH();
+  }
+  WRITE_h:  out << "Number is: " << cell[ip->arg] << '\n'; ip++; DISPATCH();
+  NOOP_h:   ip++; DISPATCH();
+  STOP_h:
+  
+  #undef DISPATCH
+  #undef WRAP
+  
+  stats.instructions = count;
+  stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/*
+ * Description: Finds the next word in LINE starting at position. Words are split by spaces, tabs and \r.
+ * Passed:      The line, where to start looking (moved past the word) and where to save the word.
+ * Returns:     False if there are no more words.
+ */
+static bool nextWord(const std::string_view LINE, size_t& position, std::string_view& word)
+{
+  const char* SPACES = " \t\r";
+  size_t wordStart = LINE.find_first_not_of(SPACES, position);
+  if(wordStart == std::string_view::npos) return false;
+  
+  size_t wordEnd = LINE.find_first_of(SPACES, wordStart);
+  if(wordEnd == std::string_view::npos) wordEnd = LINE.size();
+  
+  word = LINE.substr(wordStart, wordEnd - wordStart);
+  position = wordEnd;
+  return true;
+}
+
+//Checks if WORD is a integer with an optional sign
+static bool isInteger(const std::string_view WORD)
+{
+  size_t i = (WORD[0] == '-' || WORD[0] == '+') ? 1 : 0;
+  if(i == WORD.size()) return false;
+  
+  for(; i < WORD.size(); i++)
+    if(WORD[i] < '0' || WORD[i] > '9') return false;
+  
+  return true;
+}
+
+//Converts a integer WORD to its value, wrapping at 32 bits like the arithmetic does
+static int32_t toInteger(const std::string_view WORD)
+{
+  uint32_t value = 0;
+  size_t i = (WORD[0] == '-' || WORD[0] == '+') ? 1 : 0;
+  for(; i < WORD.size(); i++)
+    value = value * 10 + (WORD[i] - '0');
+  
+  if(WORD[0] == '-') value = 0u - value;
+  return static_cast<int32_t>(value);
+}
+
+//Throws a invalid_argument error with MESSAGE and the LINE of the program it was found on
+static void handleError(const std::string MESSAGE, const int LINE)
+{
+  throw std::invalid_argument("Error: " + MESSAGE + " || Line: " + std::to_string(LINE));
+}
+
+//Throws a invalid_argument error of MESSAGE for instruction INSTRUCTION, with the source line it was made for if known
+static void runError(const Program& PROGRAM, const size_t INSTRUCTION, const std::string MESSAGE)
+{
+  if(INSTRUCTION < PROGRAM.lines.size() && PROGRAM.lines[INSTRUCTION] > 0)
+    throw std::invalid_argument(MESSAGE + " || Line: " + std::to_string(PROGRAM.lines[INSTRUCTION]));
+  throw std::invalid_argument(MESSAGE);
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+//Target language information can be found here https://comp.umsl.edu/assembler/index
+
+#ifndef VM_H
+#define VM_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "asm.h"
+
+//A decoded instruction
+struct Instruction {
+  Opcode op;    //What the instruction does
+  uint32_t arg; //Memory cell of the operand, or the index of the instruction a branch goes to
+};
+
+/*
+ * A target program decoded so it can be run without looking anything up. Every label is replaced by the
+ * index of its instruction and every operand by a memory cell. Integer operands get their own cells after
+ * the variables so every operand is read the same way. The code always ends in STOP.
+ */
+struct Program {
+  std::vector<Instruction> code;  //The instructions in order
+  std::vector<int32_t> memory;    //Starting value of every memory cell
+  std::vector<std::string> names; //Name of every variable, memory[i] is names[i] for the first names.size() cells
+  std::vector<int> lines;         //Source line every instruction was made for, 0 if unknown, none when loaded from text
+  std::vector<std::pair<uint32_t, std::string>> labels; //Index of the instruction every label is on and its name
+};
+
+//What running a program did
+struct VmStats {
+  uint64_t instructions; //How many instructions were executed
+  double seconds;        //How long the program ran
+};
+
+/*
+ * Description: Decodes the target program in SOURCE. Each line is either [label:] instruction [argument]
+ *              or a variable followed by its starting value.
+ *              Throws a invalid_argument error if the program is malformed.
+ * Passed:      The text of the program
+ * Returns:     The decoded program
+ */
+Program loadProgram(const std::string_view SOURCE);
+
+/*
+ * Description: Runs PROGRAM until STOP. READ prompts on out and reads from in, WRITE prints to out.
+ *              Arithmetic wraps at 32 bits. Throws a invalid_argument error on division by zero and INT_MIN / -1,
+ *              ending in the source line of the division when PROGRAM has it.
+ * Passed:      The program to run, the streams it reads and writes and where to save what it did.
+ */
+void runProgram(const Program& PROGRAM, std::istream& in, std::ostream& out, VmStats& stats);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+//Runs the programs compile generates. Target language information can be found here https://comp.umsl.edu/assembler/index
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "source.h"
+#include "vm.h"
+#include "object.h"
+
+static void exitError(const std::string S);
+
+
+int main(int argc, char *argv[]) 
+{
+  bool showStats = false;
+  bool disasm = false;
+  std::string fileName;
+  
+  for(int i = 1; i < argc; i++)
+  {
+    std::string argument = argv[i];
+    if(argument == "--stats") showStats = true; //Print instruction count and speed when done
+    else if(argument == "--disasm") disasm = true; //Print the program as target text instead of running it
+    else if(fileName.empty()) fileName = argument;
+    else exitError("Too many arguments");
+  }
+  if(fileName.empty()) exitError("Usage: vm [--stats] [--disasm] file.asm|file.bin");
+  
+  std::unique_ptr<SourceBuffer> source;
+  try
+  {
+    source.reset(new SourceBuffer(fileName));
+  }
+  catch(const std::invalid_argument &e) //Program file could not be opened
+  {
+    exitError("File does not exist!");
+  }
+  
+  VmStats stats;
+  try
+  {
+    //A binary object (object.h) is told apart from target text by its magic
+    size_t size = source->end() - source->begin();
+    Program program = isObject(source->begin(), size) ? loadObject(source->begin(), size)
+                                                      : loadProgram(std::string_view(source->begin(), size));
+    if(disasm)
+    {
+      disassemble(program, std::cout);
+      return 0;
+    }
+    runProgram(program, std::cin, std::cout, stats);
+  }
+  catch(const std::invalid_argument &e) //Bad program, bad object or division that faults
+  {
+    std::cout.flush();
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  std::cout.flush();
+  
+  if(showStats)
+  {
+    double rate = stats.seconds > 0 ? stats.instructions / stats.seconds : 0;
+    std::cerr << "Instructions: " << stats.instructions << std::endl;
+    std::cerr << "Seconds: " << stats.seconds << std::endl;
+    std::cerr << "Instructions/sec: " << static_cast<uint64_t>(rate) << std::endl;
+  }
+
+  return 0;
+}
+
+
+/*
+ *  Description: Helper function that exits the program on an error.
+ *  Passed: Is passed a string to print.
+ *  Return: Exits the program
+ */
+static void exitError(const std::string S) 
+{
+  std::cout << S << std::endl;
+  exit(1);
+}
\ No newline at end of file